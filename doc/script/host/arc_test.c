@@ -0,0 +1,64 @@
+/*
+  arc_test.c - checks the end positions of native arc blocks
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Runs arcs of all sizes through the parser, planner, segment generator and stepper interrupt, including
+// arcs longer than a compact planner block holds, and G64 blended corners with path blending. The
+// machine position must end exactly on the programmed position of every program. Built with the address
+// sanitizer, which catches axis indices beyond N_AXIS, as of the helical axis of 2-axis builds.
+
+#include "host.h"
+
+static const char *programs[][6] = {
+  { "G90G1X0Y0F3000", "G2X1010Y0I505J0", NULL },
+  { "G90G1X0Y0F3000", "G3X0Y0I300J0", "G2X20Y20R20", "G3X0Y0R-20", NULL },
+  { "G90G1X0Y0F3000", "G93G2X10Y0I5J0F20", "G94G3X0Y0I-5J0F1000", NULL },
+  { "G90G1X0Y0F3000", "G91G2X0.1Y0.1I0.1J0", "G3X-0.1Y-0.1R0.1", "G90", NULL },
+  #ifdef ENABLE_PATH_BLENDING
+    { "G90G64P0.5G1X0Y0F3000", "X50", "Y50", "X0", "Y0", "G61" },
+  #endif
+};
+
+
+int main()
+{
+  host_init();
+  uint8_t failed = false;
+  int program, line, idx;
+  for (program=0; program<(int)(sizeof(programs)/sizeof(programs[0])); program++) {
+    for (line=0; (line<6) && (programs[program][line] != NULL); line++) {
+      if (host_execute_line(programs[program][line]) != STATUS_OK) {
+        fprintf(stderr, "error in program %d: %s\n", program, programs[program][line]);
+        return(1);
+      }
+    }
+    host_run_to_idle();
+
+    printf("program %d position", program);
+    for (idx=0; idx<N_AXIS; idx++) {
+      int32_t expected = lround(gc_state.position[idx]*settings.steps_per_mm[idx]);
+      printf(" %ld (%ld)", (long)sys_position[idx], (long)expected);
+      if (sys_position[idx] != expected) { failed = true; }
+    }
+    printf("\n");
+  }
+  if (failed) {
+    printf("FAILED\n");
+    return(1);
+  }
+  return(0);
+}
@@ -0,0 +1,4 @@
+// Host stand-in of avr/interrupt.h. Interrupt handlers are plain functions.
+#define ISR(vector) void vector(void)
+#define sei()
+#define cli()
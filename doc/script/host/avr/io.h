@@ -0,0 +1,114 @@
+/*
+  avr/io.h - host stand-in of the AVR register definitions used by Grbl
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Registers are plain host memory. Writes have no side effects, so the timers and the serial port
+// don't run. The host tests call the interrupt handlers themselves.
+
+#ifndef host_avr_io_h
+#define host_avr_io_h
+
+#include <stdint.h>
+
+extern uint8_t host_io_registers[];
+extern uint16_t host_io_registers_16[];
+#define _HOST_R8(n) (*(volatile uint8_t *)&host_io_registers[n])
+#define _HOST_R16(n) (*(volatile uint16_t *)&host_io_registers_16[n])
+#define HOST_IO_REGISTER_COUNT 64
+
+#define DDRB    _HOST_R8(0)
+#define DDRD    _HOST_R8(1)
+#define PORTB   _HOST_R8(2)
+#define PORTD   _HOST_R8(3)
+#define PINB    _HOST_R8(4)
+#define PIND    _HOST_R8(5)
+#define EECR    _HOST_R8(6)
+#define EEDR    _HOST_R8(7)
+#define SPMCSR  _HOST_R8(8)
+#define SREG    _HOST_R8(9)
+#define TCCR0A  _HOST_R8(10)
+#define TCCR0B  _HOST_R8(11)
+#define TCNT0   _HOST_R8(12)
+#define OCR0A   _HOST_R8(13)
+#define TIMSK0  _HOST_R8(14)
+#define TCCR1A  _HOST_R8(15)
+#define TCCR1B  _HOST_R8(16)
+#define TIMSK1  _HOST_R8(17)
+#define TIFR1   _HOST_R8(18)
+#define TCCR2A  _HOST_R8(19)
+#define TCCR2B  _HOST_R8(20)
+#define TCNT2   _HOST_R8(21)
+#define TIMSK2  _HOST_R8(22)
+#define TIFR2   _HOST_R8(23)
+#define UBRR0H  _HOST_R8(24)
+#define UBRR0L  _HOST_R8(25)
+#define UCSR0A  _HOST_R8(26)
+#define UCSR0B  _HOST_R8(27)
+#define UDR0    _HOST_R8(28)
+#define EEAR    _HOST_R16(0)
+#define OCR1A   _HOST_R16(1)
+
+#define CS00 0
+#define CS01 1
+#define CS02 2
+#define CS10 0
+#define CS11 1
+#define CS12 2
+#define CS20 0
+#define CS21 1
+#define CS22 2
+#define WGM10 0
+#define WGM11 1
+#define WGM12 3
+#define WGM13 4
+#define COM1A0 6
+#define COM1A1 7
+#define COM1B0 4
+#define COM1B1 5
+#define TOIE0 0
+#define OCIE0A 1
+#define OCIE0B 2
+#define TOIE1 0
+#define OCIE1A 1
+#define OCF1A 1
+#define TOIE2 0
+#define TOV2 0
+#define U2X0 1
+#define TXEN0 3
+#define RXEN0 4
+#define UDRIE0 5
+#define RXCIE0 7
+#define EERE 0
+#define EEPE 1
+#define EEMPE 2
+#define EERIE 3
+#define EEPM0 4
+#define EEPM1 5
+#define SELFPRGEN 0
+
+// Named address space of avr-gcc. Flash data is plain host memory.
+#define __flash
+
+// Interrupt handlers, called by the host tests.
+#define USART_RX_vect host_serial_rx_isr
+#define USART_UDRE_vect host_serial_udre_isr
+#define TIMER1_COMPA_vect host_stepper_isr
+#define TIMER0_OVF_vect host_stepper_reset_isr
+#define TIMER0_COMPA_vect host_stepper_delay_isr
+#define TIMER2_OVF_vect host_timer2_overflow_isr
+
+#endif
@@ -0,0 +1,7 @@
+// Host stand-in of avr/pgmspace.h. Program memory is plain host memory.
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(p) (*(const unsigned char *)(p))
+#define pgm_read_byte_near(p) (*(const unsigned char *)(p))
+#define pgm_read_word(p) (*(const uint16_t *)(p))
+#define pgm_read_word_near(p) (*(const uint16_t *)(p))
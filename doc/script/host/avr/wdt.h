@@ -0,0 +1 @@
+// Host stand-in of avr/wdt.h.
@@ -0,0 +1,110 @@
+/*
+  gcode_bench.c - counts the g-code lines per second of the parser
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Executes a program of typical streamed G0/G1 lines, as a CAM program sends them, over and over.
+// Counts the lines per second of the parser alone, in check mode, and of the parser with the planner.
+// The planner buffer is emptied whenever it fills up, as if the blocks were executed instantly. Built
+// once per parser option, such that the fast path and fixed-point coordinates are compared with the
+// full parser. Prints the final parser position, which must be the same for all builds.
+
+#include "host.h"
+
+#define PROGRAM_LINES 1000
+#define PASSES 100
+#define RUNS 7 // Best of the runs, which is the least disturbed by the host.
+
+static char program[PROGRAM_LINES][LINE_BUFFER_SIZE];
+static uint32_t random_state = 12345;
+
+static float random_value(float range)
+{
+  random_state = random_state*1103515245 + 12345;
+  return(range*((random_state >> 8) & 0xffff)/65536.0);
+}
+
+
+// Mostly bare modal axis words, with some G0/G1 words, feed rates and line numbers.
+static void make_program()
+{
+  int idx;
+  float x = 0.0, y = 0.0;
+  for (idx=0; idx<PROGRAM_LINES; idx++) {
+    x += random_value(2.0)-1.0;
+    y += random_value(2.0)-1.0;
+    if (idx % 50 == 0) {
+      sprintf(program[idx], "N%dG0X%.3fY%.3f", idx, x, y);
+    } else if (idx % 50 == 1) {
+      sprintf(program[idx], "G1X%.3fY%.3fF%d", x, y, 500+(int)random_value(2000.0));
+    } else if (idx % 10 == 0) {
+      sprintf(program[idx], "N%dX%.3fY%.3f", idx, x, y);
+    } else {
+      sprintf(program[idx], "X%.3fY%.3f", x, y);
+    }
+  }
+}
+
+
+// Returns the best lines per second of the program runs. The planner buffer is emptied, when it is full.
+static double run_program()
+{
+  char line[LINE_BUFFER_SIZE];
+  int run, pass, idx;
+  double best = 0.0;
+  for (run=0; run<RUNS; run++) {
+    double start = host_time();
+    for (pass=0; pass<PASSES; pass++) {
+      for (idx=0; idx<PROGRAM_LINES; idx++) {
+        if (plan_check_full_buffer()) { plan_reset_buffer(); }
+        strcpy(line, program[idx]);
+        if (gc_execute_line(line) != STATUS_OK) {
+          fprintf(stderr, "error in line %d: %s\n", idx, program[idx]);
+          exit(1);
+        }
+      }
+    }
+    double rate = PASSES*PROGRAM_LINES/(host_time()-start);
+    if (rate > best) { best = rate; }
+  }
+  return(best);
+}
+
+
+int main()
+{
+  host_init();
+  make_program();
+
+  #if defined(ENABLE_LINEAR_FAST_PATH) && defined(ENABLE_FIXED_POINT_COORDINATES)
+    const char *parser = "fast path, fixed-point";
+  #elif defined(ENABLE_LINEAR_FAST_PATH)
+    const char *parser = "fast path";
+  #elif defined(ENABLE_FIXED_POINT_COORDINATES)
+    const char *parser = "full parser, fixed-point";
+  #else
+    const char *parser = "full parser";
+  #endif
+
+  sys.state = STATE_CHECK_MODE;
+  double parse_rate = run_program();
+  sys.state = STATE_IDLE;
+  double plan_rate = run_program();
+
+  printf("%-24s %6.2fM lines/s parsed, %6.2fM lines/s planned. Position %.4f %.4f\n", parser,
+         1e-6*parse_rate, 1e-6*plan_rate, gc_state.position[X_AXIS], gc_state.position[Y_AXIS]);
+  return(0);
+}
@@ -0,0 +1,157 @@
+/*
+  host.c - runs Grbl's motion core on the host for tests and benchmarks
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Replaces main.c, serial.c and eeprom.c of the firmware. Serial output is discarded and the EEPROM
+// is host memory. Everything else is Grbl's own code.
+
+#include "host.h"
+#include <time.h>
+
+uint8_t host_io_registers[HOST_IO_REGISTER_COUNT];
+uint16_t host_io_registers_16[HOST_IO_REGISTER_COUNT];
+uint32_t host_isr_ticks;
+
+// Global variables of main.c.
+system_t sys;
+int32_t sys_position[N_AXIS];
+volatile uint8_t sys_rt_exec_state;
+volatile uint8_t sys_rt_exec_alarm;
+volatile uint8_t sys_rt_exec_motion_override;
+#ifdef ENABLE_CONTINUOUS_OVERRIDES
+  volatile uint8_t sys_rt_f_override_value;
+  volatile uint8_t sys_rt_r_override_value;
+#endif
+#ifdef DEBUG
+  volatile uint8_t sys_rt_exec_debug;
+#endif
+#ifdef ENABLE_MAIN_LOOP_TELEMETRY
+  sys_telemetry_t sys_telemetry;
+#endif
+
+
+// Serial port. Nothing is received and all output is discarded.
+void serial_init() {}
+void serial_write(uint8_t data) { (void)data; }
+uint8_t serial_read() { return(SERIAL_NO_DATA); }
+void serial_reset_read_buffer() {}
+uint8_t serial_get_rx_buffer_available() { return(RX_BUFFER_SIZE); }
+uint8_t serial_get_rx_buffer_count() { return(0); }
+uint8_t serial_get_tx_buffer_count() { return(0); }
+
+
+// EEPROM, with the checksum format of eeprom.c, including its logical or.
+static unsigned char host_eeprom[1024];
+
+unsigned char eeprom_get_char(unsigned int addr) { return(host_eeprom[addr]); }
+void eeprom_put_char(unsigned int addr, unsigned char new_value) { host_eeprom[addr] = new_value; }
+
+void memcpy_to_eeprom_with_checksum(unsigned int destination, char *source, unsigned int size)
+{
+  unsigned char checksum = 0;
+  for(; size > 0; size--) {
+    checksum = (checksum << 1) || (checksum >> 7);
+    checksum += *source;
+    eeprom_put_char(destination++, *(source++));
+  }
+  eeprom_put_char(destination, checksum);
+}
+
+int memcpy_from_eeprom_with_checksum(char *destination, unsigned int source, unsigned int size)
+{
+  unsigned char data, checksum = 0;
+  for(; size > 0; size--) {
+    data = eeprom_get_char(source++);
+    checksum = (checksum << 1) || (checksum >> 7);
+    checksum += data;
+    *(destination++) = data;
+  }
+  return(checksum == eeprom_get_char(source));
+}
+
+
+void host_init()
+{
+  memset(host_io_registers, 0, sizeof(host_io_registers));
+  memset(host_io_registers_16, 0, sizeof(host_io_registers_16));
+  memset(host_eeprom, 0xff, sizeof(host_eeprom));
+  host_isr_ticks = 0;
+  settings_restore(SETTINGS_RESTORE_ALL);
+  settings_init();
+  stepper_init();
+  memset(sys_position, 0, sizeof(sys_position));
+
+  // Reset sequence of main().
+  memset(&sys, 0, sizeof(system_t));
+  sys.f_override = DEFAULT_FEED_OVERRIDE;
+  sys.r_override = DEFAULT_RAPID_OVERRIDE;
+  sys_rt_exec_state = 0;
+  sys_rt_exec_alarm = 0;
+  sys_rt_exec_motion_override = 0;
+  gc_init();
+  plan_reset();
+  #ifdef ENABLE_PARSE_AHEAD_QUEUE
+    mc_reset_queue();
+  #endif
+  #ifdef ENABLE_INCREMENTAL_ARCS
+    mc_reset_arc();
+  #endif
+  st_reset();
+  plan_sync_position();
+  gc_sync_position();
+}
+
+
+uint8_t host_run_stepper()
+{
+  if (!(TIMSK1 & (1<<OCIE1A))) {
+    // Steppers idle. Start a cycle, if any motion is queued, as the main loop does.
+    if (plan_get_current_block() == NULL) { return(false); }
+    system_set_exec_state_flag(EXEC_CYCLE_START);
+  }
+  protocol_execute_realtime(); // Also refills the segment buffer in a cycle.
+  if (!(TIMSK1 & (1<<OCIE1A))) { return(plan_get_current_block() != NULL); }
+  host_stepper_isr();
+  host_stepper_reset_isr();
+  host_isr_ticks++;
+  return(true);
+}
+
+
+void host_run_to_idle()
+{
+  while (host_run_stepper()) {}
+  protocol_execute_realtime(); // End the cycle.
+}
+
+
+uint8_t host_execute_line(const char *line)
+{
+  char block[LINE_BUFFER_SIZE];
+  strncpy(block, line, LINE_BUFFER_SIZE-1);
+  block[LINE_BUFFER_SIZE-1] = 0;
+  while (plan_check_full_buffer()) { host_run_stepper(); }
+  return(gc_execute_line(block));
+}
+
+
+double host_time()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return(ts.tv_sec + 1e-9*ts.tv_nsec);
+}
@@ -0,0 +1,50 @@
+/*
+  host.h - runs Grbl's motion core on the host for tests and benchmarks
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef host_h
+#define host_h
+
+#include "grbl.h"
+#include <stdio.h>
+
+// Interrupt handlers of the stepper module, as named by the host avr/io.h.
+void host_stepper_isr(void);
+void host_stepper_reset_isr(void);
+
+// Stepper driver interrupt ticks executed by host_run_stepper() since host_init().
+extern uint32_t host_isr_ticks;
+
+// Initializes Grbl with the default settings, as main() does upon power-up and a reset.
+void host_init();
+
+// Executes a g-code line. Runs the steppers while the planner buffer is full. Returns the status code.
+// NOTE: The steppers don't run within the line, so it must fit the free planner blocks. Segmented arcs
+// longer than the planner buffer never return.
+uint8_t host_execute_line(const char *line);
+
+// Runs the stepper driver interrupt for one tick, starting a cycle if blocks are queued. Returns false,
+// if there is no motion left.
+uint8_t host_run_stepper();
+
+// Runs the steppers until all queued motion is complete.
+void host_run_to_idle();
+
+// Returns the host time in seconds, for benchmarks.
+double host_time();
+
+#endif
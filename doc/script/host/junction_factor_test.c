@@ -0,0 +1,137 @@
+/*
+  junction_factor_test.c - checks the junction factor table against the exact junction speed
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Plans pairs of lines with random direction changes and axis accelerations, and compares the planned
+// junction speed with the exact formula in double precision. The junction speed must not exceed the
+// exact value beyond float round-off, and must stay within the given relative errors up to 120 and
+// 150 degrees of direction change:
+//
+//   junction_factor_test <max error up to 120 degrees> <max error up to 150 degrees>
+
+#include "host.h"
+#include <math.h>
+
+#define TRIALS 100000
+
+static uint32_t random_state = 12345;
+
+static double random_value(double range)
+{
+  random_state = random_state*1103515245 + 12345;
+  return(range*((random_state >> 8) & 0xffff)/65536.0);
+}
+
+
+// Returns the exact junction speed squared between two moves, as the planner computes it without the
+// table, but in double precision.
+static double exact_junction_speed_sqr(double *prev_mm, double *next_mm)
+{
+  double prev_length = 0.0, next_length = 0.0;
+  int idx;
+  for (idx=0; idx<N_AXIS; idx++) {
+    prev_length += prev_mm[idx]*prev_mm[idx];
+    next_length += next_mm[idx]*next_mm[idx];
+  }
+  prev_length = sqrt(prev_length);
+  next_length = sqrt(next_length);
+
+  double cos_theta = 0.0, junction_length = 0.0;
+  double junction_vec[N_AXIS];
+  for (idx=0; idx<N_AXIS; idx++) {
+    cos_theta -= (prev_mm[idx]/prev_length)*(next_mm[idx]/next_length);
+    junction_vec[idx] = next_mm[idx]/next_length - prev_mm[idx]/prev_length;
+    junction_length += junction_vec[idx]*junction_vec[idx];
+  }
+  junction_length = sqrt(junction_length);
+
+  double acceleration = SOME_LARGE_VALUE;
+  for (idx=0; idx<N_AXIS; idx++) {
+    double component = fabs(junction_vec[idx]/junction_length);
+    if (component > 0.0 && settings.acceleration[idx]/component < acceleration) {
+      acceleration = settings.acceleration[idx]/component;
+    }
+  }
+  double sin_theta_d2 = sqrt(0.5*(1.0-cos_theta));
+  return(acceleration*settings.junction_deviation*sin_theta_d2/(1.0-sin_theta_d2));
+}
+
+
+int main(int argc, char *argv[])
+{
+  if (argc < 3) {
+    fprintf(stderr, "usage: junction_factor_test <max error to 120 deg> <max error to 150 deg>\n");
+    return(2);
+  }
+  double max_error_120 = atof(argv[1]);
+  double max_error_150 = atof(argv[2]);
+  host_init();
+
+  double worst_120 = 0.0, worst_150 = 0.0, worst_excess = 0.0;
+  int trial, idx;
+  for (trial=0; trial<TRIALS; trial++) {
+    for (idx=0; idx<N_AXIS; idx++) {
+      settings.acceleration[idx] = (50.0+random_value(950.0))*60*60;
+    }
+    // Direction change of 5 to 179 degrees from a random starting direction. Smaller changes are
+    // dominated by the float round-off of the junction vector, with or without the table.
+    double heading = random_value(2.0*M_PI);
+    double change = (5.0+random_value(174.0))*M_PI/180.0;
+    if (trial & 1) { change = -change; }
+    float target[N_AXIS] = {0.0};
+    float first[N_AXIS] = {0.0};
+    first[X_AXIS] = 50.0*cos(heading);
+    first[Y_AXIS] = 50.0*sin(heading);
+    target[X_AXIS] = first[X_AXIS]+50.0*cos(heading+change);
+    target[Y_AXIS] = first[Y_AXIS]+50.0*sin(heading+change);
+
+    // The planner moves in whole steps, so the exact speed uses the same rounded moves.
+    double prev_mm[N_AXIS], next_mm[N_AXIS];
+    for (idx=0; idx<N_AXIS; idx++) {
+      double start = lround(first[idx]*settings.steps_per_mm[idx]);
+      double end = lround(target[idx]*settings.steps_per_mm[idx]);
+      prev_mm[idx] = start/settings.steps_per_mm[idx];
+      next_mm[idx] = (end-start)/settings.steps_per_mm[idx];
+    }
+
+    plan_reset();
+    plan_sync_position();
+    plan_line_data_t pl_data;
+    memset(&pl_data, 0, sizeof(plan_line_data_t));
+    pl_data.condition = PL_COND_FLAG_RAPID_MOTION;
+    plan_buffer_line(first, &pl_data);
+    plan_buffer_line(target, &pl_data);
+    plan_discard_current_block();
+    double planned = plan_get_current_block()->max_junction_speed_sqr;
+    double exact = exact_junction_speed_sqr(prev_mm, next_mm);
+
+    double error = 1.0-planned/exact;
+    double degrees = fabs(change)*180.0/M_PI;
+    if (-error > worst_excess) { worst_excess = -error; }
+    if (degrees <= 120.0 && error > worst_120) { worst_120 = error; }
+    if (degrees <= 150.0 && error > worst_150) { worst_150 = error; }
+  }
+
+  printf("junction speed error: %.4f%% to 120 deg, %.4f%% to 150 deg, %.6f%% above exact\n",
+         100.0*worst_120, 100.0*worst_150, 100.0*worst_excess);
+  // Float round-off of u = 1+cos(theta) for small direction changes may exceed the exact value slightly.
+  if (worst_excess > 1e-4 || worst_120 > max_error_120 || worst_150 > max_error_150) {
+    printf("FAILED\n");
+    return(1);
+  }
+  return(0);
+}
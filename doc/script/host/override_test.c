@@ -0,0 +1,120 @@
+/*
+  override_test.c - checks the final position of short moves under override storms
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Runs a random program of mostly short G0/G1 moves, while the overrides change every few stepper
+// interrupt ticks, as when an operator spins an override knob. Every change re-plans the executing
+// block mid-ramp. Built once per combination of velocity profile and override options. The machine
+// position must end exactly on the programmed position, within a bounded number of ticks.
+//
+//   override_test [moves] [random seed]
+
+#include "host.h"
+
+#define OVERRIDE_INTERVAL 37 // Stepper interrupt ticks between override changes
+#define MAX_TICKS_PER_MOVE 2000000L
+
+static uint32_t random_state = 12345;
+
+static float random_value(float range)
+{
+  random_state = random_state*1103515245 + 12345;
+  return(range*((random_state >> 8) & 0xffff)/65536.0);
+}
+
+
+// Changes the feed or rapid override by a random step or, with continuous overrides, to a random value.
+static void change_override()
+{
+  #ifdef ENABLE_CONTINUOUS_OVERRIDES
+    if (random_state & 0x100) {
+      if (random_state & 0x200) {
+        sys_rt_r_override_value = RAPID_OVERRIDE_LOW+(uint8_t)random_value(DEFAULT_RAPID_OVERRIDE-RAPID_OVERRIDE_LOW);
+      } else {
+        sys_rt_f_override_value = MIN_FEED_RATE_OVERRIDE+(uint8_t)random_value(MAX_FEED_RATE_OVERRIDE-MIN_FEED_RATE_OVERRIDE);
+      }
+      return;
+    }
+  #endif
+  static const uint8_t flags[] = { EXEC_FEED_OVR_RESET, EXEC_FEED_OVR_COARSE_PLUS, EXEC_FEED_OVR_COARSE_MINUS,
+                                   EXEC_FEED_OVR_FINE_PLUS, EXEC_FEED_OVR_FINE_MINUS, EXEC_RAPID_OVR_RESET,
+                                   EXEC_RAPID_OVR_MEDIUM, EXEC_RAPID_OVR_LOW };
+  system_set_exec_motion_override_flag(flags[(int)random_value(8.0)]);
+}
+
+
+// Runs one stepper interrupt tick with the override storm. Returns false, if there is no motion left.
+static uint8_t storm_tick()
+{
+  if ((host_isr_ticks % OVERRIDE_INTERVAL) == 0) { change_override(); }
+  return(host_run_stepper());
+}
+
+
+int main(int argc, char *argv[])
+{
+  int moves = 400;
+  if (argc > 1) { moves = atoi(argv[1]); }
+  if (argc > 2) { random_state = atol(argv[2]); }
+  host_init();
+  #ifdef ENABLE_CONTINUOUS_OVERRIDES
+    settings.override_slew_rate = 500.0; // (percent/sec)
+  #endif
+
+  int idx;
+  char line[LINE_BUFFER_SIZE];
+  for (idx=0; idx<moves; idx++) {
+    // Mostly very short moves, which never reach their nominal speed, and some longer ones.
+    float range = (idx % 10 == 0) ? 10.0 : ((idx % 3 == 0) ? 0.02 : 0.5);
+    float x = random_value(2.0*range) - range;
+    float y = random_value(2.0*range) - range;
+    int feed = 200 + (int)random_value(4000.0);
+    sprintf(line, "G91G%dX%.4fY%.4fF%d", (idx % 7 == 0) ? 0 : 1, x, y, feed);
+    while (plan_check_full_buffer()) {
+      storm_tick();
+      if (host_isr_ticks > (idx+1)*MAX_TICKS_PER_MOVE) {
+        fprintf(stderr, "no progress in line %d\n", idx);
+        return(1);
+      }
+    }
+    if (host_execute_line(line) != STATUS_OK) {
+      fprintf(stderr, "error in line %d: %s\n", idx, line);
+      return(1);
+    }
+  }
+  while (storm_tick()) {
+    if (host_isr_ticks > (moves+1)*MAX_TICKS_PER_MOVE) {
+      fprintf(stderr, "no end of motion\n");
+      return(1);
+    }
+  }
+  protocol_execute_realtime();
+
+  uint8_t failed = false;
+  printf("position");
+  for (idx=0; idx<N_AXIS; idx++) {
+    int32_t expected = lround(gc_state.position[idx]*settings.steps_per_mm[idx]);
+    printf(" %ld (%ld)", (long)sys_position[idx], (long)expected);
+    if (sys_position[idx] != expected) { failed = true; }
+  }
+  printf("\n");
+  if (failed) {
+    printf("FAILED\n");
+    return(1);
+  }
+  return(0);
+}
@@ -0,0 +1,53 @@
+/*
+  planner_bench.c - times the planner recalculation of a full buffer
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Fills the planner buffer with short zigzag moves and replans it from the tail over and over, as after
+// a feed hold. Each pass walks the whole buffer backward and forward, which is the worst case of the
+// planner passes. Prints the time per pass and per block for the compiled BLOCK_BUFFER_SIZE.
+
+#include "host.h"
+
+#define PASSES 200000
+
+
+int main()
+{
+  host_init();
+
+  int line_count = 0;
+  char line[LINE_BUFFER_SIZE];
+  while (!plan_check_full_buffer()) {
+    sprintf(line, "G91G1X1Y%sF3000", (line_count & 1) ? "0.2" : "-0.2");
+    if (host_execute_line(line) != STATUS_OK) { return(1); }
+    line_count++;
+  }
+
+  int pass;
+  double start = host_time();
+  for (pass=0; pass<PASSES; pass++) { plan_cycle_reinitialize(); }
+  double elapsed = host_time()-start;
+
+  #ifdef USE_SPLIT_PLANNER_PROFILES
+    const char *layout = "split";
+  #else
+    const char *layout = "block";
+  #endif
+  printf("%3d blocks, %s profiles: %7.1f ns per pass, %5.2f ns per block\n", line_count, layout,
+         1e9*elapsed/PASSES, 1e9*elapsed/PASSES/line_count);
+  return(0);
+}
@@ -0,0 +1,74 @@
+/*
+  segment_trace.c - prints the step output of a random program, tick by tick
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Runs a random program of G0/G1 moves of all lengths through the parser, planner, segment generator
+// and stepper interrupt. Prints the step and direction outputs and the timer compare value of every
+// interrupt tick, and the final machine position. Built once per segment generator option, such that
+// trace_compare can check the step output of the options against each other.
+
+#include "host.h"
+
+static uint32_t random_state = 12345;
+
+static float random_value(float range)
+{
+  random_state = random_state*1103515245 + 12345;
+  return(range*((random_state >> 8) & 0xffff)/65536.0);
+}
+
+
+// Runs one stepper interrupt tick and prints its outputs. Returns false, if there is no motion left.
+static uint8_t trace_tick()
+{
+  uint32_t ticks = host_isr_ticks;
+  uint8_t busy = host_run_stepper();
+  if (host_isr_ticks != ticks) {
+    printf("%02x %02x %u\n", STEP_PORT & STEP_MASK, DIRECTION_PORT & DIRECTION_MASK, OCR1A);
+  }
+  return(busy);
+}
+
+
+int main(int argc, char *argv[])
+{
+  int moves = 300;
+  if (argc > 1) { moves = atoi(argv[1]); }
+  host_init();
+
+  int idx;
+  char line[LINE_BUFFER_SIZE];
+  for (idx=0; idx<moves; idx++) {
+    // Mostly short moves, which are dominated by acceleration, and some long ones.
+    float range = (idx % 10 == 0) ? 20.0 : ((idx % 3 == 0) ? 0.5 : 5.0);
+    float x = random_value(2.0*range) - range;
+    float y = random_value(2.0*range) - range;
+    int feed = 100 + (int)random_value(3000.0);
+    sprintf(line, "G91G%dX%.3fY%.3fF%d", (idx % 7 == 0) ? 0 : 1, x, y, feed);
+    while (plan_check_full_buffer()) { trace_tick(); }
+    if (host_execute_line(line) != STATUS_OK) {
+      fprintf(stderr, "error in line %d: %s\n", idx, line);
+      return(1);
+    }
+  }
+  while (trace_tick()) {}
+
+  printf("position");
+  for (idx=0; idx<N_AXIS; idx++) { printf(" %ld", (long)sys_position[idx]); }
+  printf("\n");
+  return(0);
+}
@@ -0,0 +1,87 @@
+/*
+  trace_compare.c - compares the step output traces of two segment generator builds
+  Part of Grbl
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Compares two segment_trace outputs. The step and direction outputs of every tick and the final
+// position must be identical. The tick timing may differ by the partial step time quantization of
+// fixed-point segment prep, 1/256 step, so each tick may differ by up to MAX_TICK_ERROR and the total
+// execution time by up to MAX_TOTAL_ERROR.
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#define MAX_TICK_ERROR (2.0/256.0)
+#define MAX_TOTAL_ERROR 1e-4
+
+int main(int argc, char *argv[])
+{
+  if (argc != 3) {
+    fprintf(stderr, "usage: trace_compare <trace> <reference trace>\n");
+    return(2);
+  }
+  FILE *file = fopen(argv[1], "r");
+  FILE *reference = fopen(argv[2], "r");
+  if (!file || !reference) {
+    fprintf(stderr, "can't open traces\n");
+    return(2);
+  }
+
+  char line[256], reference_line[256];
+  unsigned long ticks = 0;
+  double total = 0.0, reference_total = 0.0, max_tick_error = 0.0;
+  for (;;) {
+    char *read = fgets(line, sizeof(line), file);
+    char *reference_read = fgets(reference_line, sizeof(reference_line), reference);
+    if (!read || !reference_read) {
+      if (read || reference_read) {
+        printf("FAIL: tick count differs after %lu ticks\n", ticks);
+        return(1);
+      }
+      break;
+    }
+    unsigned step_bits, direction_bits, cycles;
+    unsigned reference_step_bits, reference_direction_bits, reference_cycles;
+    if (sscanf(line, "%x %x %u", &step_bits, &direction_bits, &cycles) != 3 ||
+        sscanf(reference_line, "%x %x %u", &reference_step_bits, &reference_direction_bits, &reference_cycles) != 3) {
+      // Final position lines.
+      if (strcmp(line, reference_line) != 0) {
+        printf("FAIL: %sdiffers from reference %s", line, reference_line);
+        return(1);
+      }
+      continue;
+    }
+    ticks++;
+    if ((step_bits != reference_step_bits) || (direction_bits != reference_direction_bits)) {
+      printf("FAIL: step output differs at tick %lu\n", ticks);
+      return(1);
+    }
+    total += cycles;
+    reference_total += reference_cycles;
+    double tick_error = fabs((double)cycles-reference_cycles)/reference_cycles;
+    if (tick_error > max_tick_error) { max_tick_error = tick_error; }
+  }
+
+  double total_error = fabs(total-reference_total)/reference_total;
+  printf("%lu ticks, identical steps. Max tick timing error %.4f%%, total time error %.6f%%\n",
+         ticks, 100.0*max_tick_error, 100.0*total_error);
+  if ((max_tick_error > MAX_TICK_ERROR) || (total_error > MAX_TOTAL_ERROR)) {
+    printf("FAIL: timing error exceeds the tolerance\n");
+    return(1);
+  }
+  return(0);
+}
@@ -0,0 +1,3 @@
+// Host stand-in of util/delay.h. Delays return immediately.
+static inline void _delay_us(double us) { (void)us; }
+static inline void _delay_ms(double ms) { (void)ms; }
@@ -0,0 +1,161 @@
+#!/usr/bin/env python
+"""\
+
+Stream g-code to grbl as binary motion blocks
+
+Encodes the G0, G1, G2 and G3 motion lines of a g-code program as
+binary motion blocks, which grbl executes without parsing any text.
+Requires grbl compiled with ENABLE_BINARY_PROTOCOL. All other lines,
+such as modal commands, are sent as text. Both share the active modal
+state in grbl, so the program runs exactly as when streamed as text.
+
+A motion line may hold one G0-G3 command and the axis, arc offset, R
+and F words. The values are sent as 32-bit floats in the units and
+distance mode of the program.
+
+Blocks are sent with the same character-counting protocol as
+stream.py, and each block is replied to with an 'ok' or an error.
+With the '-o' option, the stream is written to a file instead.
+
+---------------------
+The MIT License (MIT)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+---------------------
+"""
+
+from __future__ import print_function
+import re
+import sys
+import time
+import struct
+import argparse
+
+RX_BUFFER_SIZE = 128
+BAUD_RATE = 115200
+
+# Must match grbl's config.h and gcode.h.
+N_AXIS = 2
+CMD_BINARY_BLOCK = 0xAB
+CMD_FRAME_ESCAPE = 0xA7
+CMD_RESET = 0x18
+# Word mask bit order: axis words, arc offset words, R and F.
+WORD_LETTERS = 'XYZ'[:N_AXIS] + 'IJK'[:N_AXIS] + 'RF'
+
+# Define command line argument interface
+parser = argparse.ArgumentParser(description='Stream g-code file to grbl as binary motion blocks. (pySerial and argparse libraries required)')
+parser.add_argument('gcode_file', type=argparse.FileType('r'),
+        help='g-code filename to be streamed')
+parser.add_argument('device_file', nargs='?',
+        help='serial device path')
+parser.add_argument('-o','--output', type=argparse.FileType('wb'),
+        help='write the stream to a file instead of sending it')
+parser.add_argument('-q','--quiet', action='store_true', default=False,
+        help='suppress output text')
+args = parser.parse_args()
+if not args.device_file and not args.output :
+    parser.error('either a serial device or an output file is required')
+
+
+def encode_block(l_block) :
+    # Returns the binary motion block of a motion line, or None if it must be sent as text.
+    words = re.findall(r'([A-Z])([-+]?[0-9.]*)', l_block)
+    if ''.join(letter+value for letter, value in words) != l_block : return None
+    motion = 0
+    values = {}
+    for letter, value in words :
+        try : value = float(value)
+        except ValueError : return None
+        if letter == 'G' :
+            if motion or value not in (0, 1, 2, 3) : return None
+            motion = int(value)+1
+        elif letter in WORD_LETTERS and letter not in values :
+            values[letter] = value
+        else : return None
+    word_mask = 0
+    data = b''
+    for idx, letter in enumerate(WORD_LETTERS) :
+        if letter in values :
+            word_mask |= 1 << idx
+            data += struct.pack('<f', values[letter])
+    # Grbl recognizes a reset within a frame. Escape data bytes equal to CMD_RESET or CMD_FRAME_ESCAPE.
+    frame = bytearray([CMD_BINARY_BLOCK])
+    for c in bytearray(struct.pack('<BB', motion, word_mask) + data) :
+        if c in (CMD_RESET, CMD_FRAME_ESCAPE) : frame.append(CMD_FRAME_ESCAPE)
+        frame.append(c)
+    return bytes(frame)
+
+
+# Encode the program. Each block is a binary frame or a text line.
+blocks = []
+text_bytes = 0
+for line in args.gcode_file :
+    l_block = re.sub(r'\s|\(.*?\)|;.*','',line).upper() # Strip comments/spaces/new line and capitalize
+    if not l_block : continue
+    text_bytes += len(l_block)+1
+    block = encode_block(l_block)
+    if block is None : block = (l_block+'\n').encode('ascii')
+    blocks.append(block)
+stream_bytes = sum(len(block) for block in blocks)
+print("Encoded", len(blocks), "blocks into", stream_bytes, "bytes, instead of", text_bytes, "text bytes")
+
+if args.output :
+    for block in blocks : args.output.write(block)
+    args.output.close()
+    print("Stream written to", args.output.name)
+    sys.exit(0)
+
+import serial
+s = serial.Serial(args.device_file, BAUD_RATE)
+print("Initializing Grbl...")
+s.write(b"\r\n\r\n")
+time.sleep(2) # Wait for grbl to initialize and flush startup text in serial input
+s.flushInput()
+
+
+def read_response(s) :
+    return s.readline().strip().decode('ascii', 'replace')
+
+
+# Stream blocks with grbl's character-counting protocol.
+start_time = time.time()
+c_block = []
+ok_count = 0
+error_count = 0
+def receive() :
+    global ok_count, error_count
+    grbl_out = read_response(s)
+    if grbl_out.find('ok') < 0 and grbl_out.find('error') < 0 :
+        print("    MSG: \""+grbl_out+"\"")
+    else :
+        if grbl_out.find('error') >= 0 : error_count += 1
+        ok_count += 1
+        if not args.quiet : print("  REC<"+str(ok_count)+": \""+grbl_out+"\"")
+        del c_block[0]
+for block in blocks :
+    c_block.append(len(block))
+    while sum(c_block) >= RX_BUFFER_SIZE-1 or s.inWaiting() : receive()
+    s.write(block)
+while ok_count < len(blocks) : receive()
+
+print("\nBinary streaming finished!")
+print(" Time elapsed: ", time.time()-start_time)
+if error_count > 0 : print(" Errors:", error_count)
+print("WARNING: Wait until Grbl completes buffered g-code blocks before exiting.")
+s.close()
@@ -0,0 +1,420 @@
+#!/usr/bin/env python
+"""\
+
+Stream host-computed step segments to grbl
+
+Plans a g-code program off-line and streams the resulting step
+segments to grbl, which queues them directly in its segment buffer.
+Requires grbl compiled with ENABLE_SEGMENT_STREAMING. The program is
+planned and segmented with the same math as grbl's planner.c and
+stepper.c, so the motion is the same as when grbl plans it, except
+that the whole program is planned at once.
+
+Only G0 and G1 motions in absolute millimeters (G90 G21) are
+supported. Grbl settings are read from grbl with '$$', or from a file
+of '$$' output, such that the frames may be written to a file without
+a grbl connected.
+
+With the '-b' option, the planned blocks are streamed instead, which
+grbl queues in its planner buffer with the planned entry and exit
+speeds as limits. Requires grbl compiled with ENABLE_PREPLANNED_BLOCKS.
+Grbl still plans the last buffered block to a stop, computes the
+segments itself and applies feed holds and overrides as usual.
+
+Frames are sent with the same character-counting protocol as
+stream.py. Each frame is replied to with an 'ok'. An empty line ends
+the streamed motion, where grbl replies once segment motion completes.
+
+NOTE: Streamed segments start immediately and are not subject to
+feed holds, overrides or deceleration by grbl. If the serial link
+can't keep up, the motion stops abruptly.
+
+---------------------
+The MIT License (MIT)
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+---------------------
+"""
+
+from __future__ import print_function
+import re
+import sys
+import math
+import time
+import struct
+import argparse
+
+RX_BUFFER_SIZE = 128
+BAUD_RATE = 115200
+
+# Must match grbl's config.h.
+N_AXIS = 2
+CMD_SEGMENT_BLOCK = 0xA8
+CMD_SEGMENT = 0xA9
+CMD_PLANNED_BLOCK = 0xAA
+CMD_FRAME_ESCAPE = 0xA7
+CMD_RESET = 0x18
+F_CPU = 16000000
+ACCELERATION_TICKS_PER_SECOND = 100
+MINIMUM_JUNCTION_SPEED = 0.0 # (mm/min)
+MINIMUM_FEED_RATE = 1.0 # (mm/min)
+
+DT_SEGMENT = 1.0/(ACCELERATION_TICKS_PER_SECOND*60.0) # (min/segment)
+REQ_MM_INCREMENT_SCALAR = 1.25
+CYCLES_PER_MINUTE = F_CPU*60.0
+
+# Define command line argument interface
+parser = argparse.ArgumentParser(description='Stream host-computed step segments of a g-code file to grbl. (pySerial and argparse libraries required)')
+parser.add_argument('gcode_file', type=argparse.FileType('r'),
+        help='g-code filename to be streamed')
+parser.add_argument('device_file', nargs='?',
+        help='serial device path')
+parser.add_argument('-s','--settings', type=argparse.FileType('r'),
+        help='file of grbl \'$$\' output, instead of reading the settings from grbl')
+parser.add_argument('-o','--output', type=argparse.FileType('wb'),
+        help='write the frames to a file instead of streaming them')
+parser.add_argument('-b','--blocks', action='store_true', default=False,
+        help='stream host-planned blocks instead of step segments')
+args = parser.parse_args()
+if not args.device_file and not args.output :
+    parser.error('either a serial device or an output file is required')
+if not args.device_file and not args.settings :
+    parser.error('a settings file is required without a serial device')
+
+
+def parse_settings(lines) :
+    settings = {}
+    for line in lines :
+        m = re.match(r'\$(\d+)=([-0-9.]+)', line.strip())
+        if m : settings[int(m.group(1))] = float(m.group(2))
+    return settings
+
+
+def limit_value_by_axis_maximum(max_value, unit_vec) :
+    # Same as planner.c: the largest value along the unit vector within each axis maximum.
+    limit_value = 1e38
+    for idx in range(N_AXIS) :
+        if unit_vec[idx] != 0 :
+            limit_value = min(limit_value, abs(max_value[idx]/unit_vec[idx]))
+    return limit_value
+
+
+class Block :
+    pass
+
+
+def plan_program(f, settings) :
+    steps_per_mm = [settings[100+idx] for idx in range(N_AXIS)]
+    max_rate = [settings[110+idx] for idx in range(N_AXIS)]
+    acceleration = [settings[120+idx]*60*60 for idx in range(N_AXIS)] # (mm/min^2)
+    junction_deviation = settings[11]
+
+    blocks = []
+    position_steps = [0]*N_AXIS
+    target = [0.0]*N_AXIS
+    motion = 0
+    feed_rate = 0.0
+    prev_unit_vec = None
+    prev_nominal_speed = 0.0
+    for line in f :
+        line = re.sub(r'\s|\(.*?\)|;.*','',line).upper()
+        words = re.findall(r'([A-Z])([-+]?[0-9.]+)', line)
+        has_axis = False
+        for letter, value in words :
+            value = float(value)
+            if letter == 'G' :
+                if value in (0, 1) : motion = int(value)
+                elif value not in (21, 90, 94) :
+                    sys.exit('Unsupported command G%g in line: %s' % (value, line))
+            elif letter == 'F' : feed_rate = value
+            elif letter in 'XYZ'[:N_AXIS] :
+                target['XYZ'.index(letter)] = value
+                has_axis = True
+        if not has_axis : continue
+
+        # Compute block steps and direction as in plan_buffer_line().
+        target_steps = [int(round(target[idx]*steps_per_mm[idx])) for idx in range(N_AXIS)]
+        delta_steps = [target_steps[idx]-position_steps[idx] for idx in range(N_AXIS)]
+        if max(abs(d) for d in delta_steps) == 0 : continue
+        unit_vec = [delta_steps[idx]/steps_per_mm[idx] for idx in range(N_AXIS)]
+        millimeters = math.sqrt(sum(u*u for u in unit_vec))
+        unit_vec = [u/millimeters for u in unit_vec]
+
+        b = Block()
+        b.delta_steps = delta_steps
+        b.steps = [abs(d) for d in delta_steps]
+        b.direction_mask = sum(1 << idx for idx in range(N_AXIS) if delta_steps[idx] < 0)
+        b.step_event_count = max(b.steps)
+        b.millimeters = millimeters
+        b.acceleration = limit_value_by_axis_maximum(acceleration, unit_vec)
+        rapid_rate = limit_value_by_axis_maximum(max_rate, unit_vec)
+        b.rapid_rate = rapid_rate
+        b.is_rapid = (motion == 0)
+        if motion == 0 : nominal_speed = b.programmed_rate = rapid_rate
+        else :
+            if feed_rate <= 0 : sys.exit('Undefined feed rate in line: %s' % line)
+            b.programmed_rate = feed_rate
+            nominal_speed = min(feed_rate, rapid_rate)
+        b.nominal_speed = max(nominal_speed, MINIMUM_FEED_RATE)
+
+        # Junction speed by the junction deviation, as in plan_buffer_line().
+        if prev_unit_vec is None :
+            max_junction_speed_sqr = 0.0
+        else :
+            junction_cos_theta = -sum(prev_unit_vec[idx]*unit_vec[idx] for idx in range(N_AXIS))
+            if junction_cos_theta > 0.999999 :
+                max_junction_speed_sqr = MINIMUM_JUNCTION_SPEED**2
+            elif junction_cos_theta < -0.999999 :
+                max_junction_speed_sqr = 1e38
+            else :
+                junction_unit_vec = [unit_vec[idx]-prev_unit_vec[idx] for idx in range(N_AXIS)]
+                norm = math.sqrt(sum(u*u for u in junction_unit_vec))
+                junction_unit_vec = [u/norm for u in junction_unit_vec]
+                junction_acceleration = limit_value_by_axis_maximum(acceleration, junction_unit_vec)
+                sin_theta_d2 = math.sqrt(0.5*(1.0-junction_cos_theta))
+                max_junction_speed_sqr = max(MINIMUM_JUNCTION_SPEED**2,
+                    (junction_acceleration*junction_deviation*sin_theta_d2)/(1.0-sin_theta_d2))
+        b.max_junction_speed_sqr = max_junction_speed_sqr
+        b.max_entry_speed_sqr = min(max_junction_speed_sqr, b.nominal_speed**2, prev_nominal_speed**2)
+
+        blocks.append(b)
+        position_steps = target_steps
+        prev_unit_vec = unit_vec
+        prev_nominal_speed = b.nominal_speed
+
+    # Reverse and forward passes of planner_recalculate() over the whole program, which starts and
+    # ends at rest.
+    exit_speed_sqr = 0.0
+    for b in reversed(blocks) :
+        b.entry_speed_sqr = min(b.max_entry_speed_sqr, exit_speed_sqr + 2*b.acceleration*b.millimeters)
+        exit_speed_sqr = b.entry_speed_sqr
+    entry_speed_sqr = 0.0
+    for b in blocks :
+        b.entry_speed_sqr = min(b.entry_speed_sqr, entry_speed_sqr)
+        entry_speed_sqr = b.entry_speed_sqr + 2*b.acceleration*b.millimeters
+    for idx, b in enumerate(blocks) :
+        if idx+1 < len(blocks) : b.exit_speed_sqr = blocks[idx+1].entry_speed_sqr
+        else : b.exit_speed_sqr = 0.0
+    return blocks
+
+
+RAMP_ACCEL, RAMP_CRUISE, RAMP_DECEL = range(3)
+
+def segment_block(b, dt_remainder) :
+    # Velocity profile of the block, as in st_prep_buffer().
+    mm = b.millimeters
+    current_speed = math.sqrt(b.entry_speed_sqr)
+    exit_speed = math.sqrt(b.exit_speed_sqr)
+    nominal_speed_sqr = b.nominal_speed**2
+    inv_2_accel = 0.5/b.acceleration
+    ramp_type = RAMP_ACCEL
+    accelerate_until = mm
+    decelerate_after = 0.0
+    maximum_speed = exit_speed
+    intersect_distance = 0.5*(mm+inv_2_accel*(b.entry_speed_sqr-b.exit_speed_sqr))
+    if intersect_distance > 0.0 :
+        if intersect_distance < mm : # Either trapezoid or triangle types
+            decelerate_after = inv_2_accel*(nominal_speed_sqr-b.exit_speed_sqr)
+            if decelerate_after < intersect_distance : # Trapezoid type
+                maximum_speed = b.nominal_speed
+                if b.entry_speed_sqr == nominal_speed_sqr : ramp_type = RAMP_CRUISE
+                else : accelerate_until -= inv_2_accel*(nominal_speed_sqr-b.entry_speed_sqr)
+            else : # Triangle type
+                accelerate_until = intersect_distance
+                decelerate_after = intersect_distance
+                maximum_speed = math.sqrt(2.0*b.acceleration*intersect_distance+b.exit_speed_sqr)
+        else : # Deceleration-only type
+            ramp_type = RAMP_DECEL
+    else : # Acceleration-only type
+        accelerate_until = 0.0
+        decelerate_after = 0.0
+
+    step_per_mm = b.step_event_count/mm
+    req_mm_increment = REQ_MM_INCREMENT_SCALAR/step_per_mm
+    steps_remaining = float(b.step_event_count)
+    segments = []
+    while mm > 0.0 :
+        # Segment time and distance, as in the segment generator of st_prep_buffer().
+        dt_max = DT_SEGMENT
+        dt = 0.0
+        time_var = dt_max
+        mm_remaining = mm
+        minimum_mm = max(mm_remaining-req_mm_increment, 0.0)
+        while True :
+            if ramp_type == RAMP_ACCEL :
+                speed_var = b.acceleration*time_var
+                mm_remaining -= time_var*(current_speed + 0.5*speed_var)
+                if mm_remaining < accelerate_until : # End of acceleration ramp.
+                    mm_remaining = accelerate_until
+                    time_var = 2.0*(mm-mm_remaining)/(current_speed+maximum_speed)
+                    if mm_remaining == decelerate_after : ramp_type = RAMP_DECEL
+                    else : ramp_type = RAMP_CRUISE
+                    current_speed = maximum_speed
+                else :
+                    current_speed += speed_var
+            elif ramp_type == RAMP_CRUISE :
+                mm_var = mm_remaining - maximum_speed*time_var
+                if mm_var < decelerate_after : # End of cruise.
+                    time_var = (mm_remaining - decelerate_after)/maximum_speed
+                    mm_remaining = decelerate_after
+                    ramp_type = RAMP_DECEL
+                else :
+                    mm_remaining = mm_var
+            else :
+                speed_var = b.acceleration*time_var
+                mm_var = 0.0
+                if current_speed > speed_var :
+                    mm_var = mm_remaining - time_var*(current_speed - 0.5*speed_var)
+                if mm_var > 0.0 : # In deceleration ramp.
+                    mm_remaining = mm_var
+                    current_speed -= speed_var
+                else : # End of block.
+                    time_var = 2.0*mm_remaining/(current_speed+exit_speed)
+                    mm_remaining = 0.0
+                    current_speed = exit_speed
+            dt += time_var
+            if dt < dt_max : time_var = dt_max - dt # At ramp junction.
+            elif mm_remaining > minimum_mm : # Very slow segment without a step.
+                dt_max += DT_SEGMENT
+                time_var = dt_max - dt
+            else : break
+            if mm_remaining <= 0.0 : break
+
+        # Steps and step rate of the segment with the partial step correction.
+        step_dist_remaining = step_per_mm*mm_remaining
+        n_steps_remaining = math.ceil(step_dist_remaining)
+        last_n_steps_remaining = math.ceil(steps_remaining)
+        n_step = int(last_n_steps_remaining-n_steps_remaining)
+        dt += dt_remainder
+        inv_rate = dt/(last_n_steps_remaining - step_dist_remaining)
+        cycles = int(math.ceil(CYCLES_PER_MINUTE*inv_rate))
+        segments.append((n_step, min(cycles, 0xffffffff)))
+        mm = mm_remaining
+        steps_remaining = n_steps_remaining
+        dt_remainder = (n_steps_remaining - step_dist_remaining)*inv_rate
+    return segments, dt_remainder
+
+
+def escape_frame(frame) :
+    # Grbl recognizes a reset within a frame. Escape data bytes equal to CMD_RESET or CMD_FRAME_ESCAPE.
+    data = bytearray(frame[:1])
+    for c in bytearray(frame[1:]) :
+        if c in (CMD_RESET, CMD_FRAME_ESCAPE) : data.append(CMD_FRAME_ESCAPE)
+        data.append(c)
+    return bytes(data)
+
+
+def encode_frames(blocks) :
+    frames = []
+    dt_remainder = 0.0
+    for b in blocks :
+        frames.append(escape_frame(struct.pack('<BB'+'I'*N_AXIS, CMD_SEGMENT_BLOCK, b.direction_mask, *b.steps)))
+        segments, dt_remainder = segment_block(b, dt_remainder)
+        for n_step, cycles in segments :
+            frames.append(escape_frame(struct.pack('<BHI', CMD_SEGMENT, n_step, cycles)))
+    return frames
+
+
+def encode_block_frames(blocks) :
+    # Layout of plan_host_block_t in grbl's planner.h.
+    frames = []
+    for b in blocks :
+        frames.append(escape_frame(struct.pack('<B'+'i'*N_AXIS+'f'*7+'B', CMD_PLANNED_BLOCK, *(b.delta_steps +
+            [b.millimeters, b.acceleration, b.programmed_rate, b.rapid_rate,
+             min(b.max_junction_speed_sqr, 1e38), b.entry_speed_sqr, b.exit_speed_sqr, int(b.is_rapid)]))))
+    return frames
+
+
+def read_response(s) :
+    return s.readline().strip().decode('ascii', 'replace')
+
+
+# Read settings from grbl or a file.
+s = None
+if args.device_file :
+    import serial
+    s = serial.Serial(args.device_file, BAUD_RATE)
+    print("Initializing Grbl...")
+    s.write(b"\r\n\r\n")
+    time.sleep(2) # Wait for grbl to initialize and flush startup text in serial input
+    s.flushInput()
+if args.settings :
+    settings = parse_settings(args.settings)
+else :
+    s.write(b"$$\n")
+    lines = []
+    while True :
+        grbl_out = read_response(s)
+        if grbl_out.find('ok') >= 0 : break
+        if grbl_out.find('error') >= 0 : sys.exit('Failed to read grbl settings: ' + grbl_out)
+        lines.append(grbl_out)
+    settings = parse_settings(lines)
+
+start_time = time.time()
+blocks = plan_program(args.gcode_file, settings)
+if args.blocks :
+    frames = encode_block_frames(blocks)
+    print("Planned", len(blocks), "blocks in", round(time.time()-start_time,3), "sec")
+else :
+    frames = encode_frames(blocks)
+    n_segments = len(frames)-len(blocks)
+    print("Planned", len(blocks), "blocks into", n_segments, "segments in", round(time.time()-start_time,3), "sec")
+
+if args.output :
+    for frame in frames : args.output.write(frame)
+    args.output.close()
+    print("Frames written to", args.output.name)
+    if s : s.close()
+    sys.exit(0)
+
+# Stream frames with grbl's character-counting protocol. The final empty line ends the streamed
+# motion, which grbl replies to when the motion completes.
+start_time = time.time()
+frames.append(b'\n')
+c_frame = []
+ok_count = 0
+error_count = 0
+for frame in frames :
+    c_frame.append(len(frame))
+    while sum(c_frame) >= RX_BUFFER_SIZE-1 or s.inWaiting() :
+        grbl_out = read_response(s)
+        if grbl_out.find('ok') < 0 and grbl_out.find('error') < 0 :
+            print("    MSG: \""+grbl_out+"\"")
+        else :
+            if grbl_out.find('error') >= 0 :
+                error_count += 1
+                print("  REC<"+str(ok_count+1)+": \""+grbl_out+"\"")
+            ok_count += 1
+            del c_frame[0]
+    s.write(frame)
+while ok_count < len(frames) :
+    grbl_out = read_response(s)
+    if grbl_out.find('ok') < 0 and grbl_out.find('error') < 0 :
+        print("    MSG: \""+grbl_out+"\"")
+    else :
+        if grbl_out.find('error') >= 0 :
+            error_count += 1
+            print("  REC<"+str(ok_count+1)+": \""+grbl_out+"\"")
+        ok_count += 1
+        del c_frame[0]
+
+print("\nStreaming finished!")
+print(" Time elapsed: ", time.time()-start_time)
+if error_count > 0 : print(" Errors:", error_count)
+s.close()
@@ -62,6 +62,13 @@
 #define CMD_RAPID_OVR_RESET 0x95        // Restores rapid override value to 100%.
 #define CMD_RAPID_OVR_MEDIUM 0x96
 #define CMD_RAPID_OVR_LOW 0x97
+#define CMD_FEED_OVR_SET 0x98           // Followed by a byte of the feed override value in percent.
+#define CMD_RAPID_OVR_SET 0x9F          // Followed by a byte of the rapid override value in percent.
+#define CMD_SEGMENT_BLOCK 0xA8          // Followed by the stepper block data of streamed step segments.
+#define CMD_SEGMENT 0xA9                // Followed by the data of a streamed step segment.
+#define CMD_PLANNED_BLOCK 0xAA          // Followed by the data of a host-planned block.
+#define CMD_BINARY_BLOCK 0xAB           // Followed by the words of a binary motion block.
+#define CMD_FRAME_ESCAPE 0xA7           // Escapes a frame data byte equal to CMD_RESET or itself.
 
 // Number of blocks Grbl executes upon startup. These blocks are stored in EEPROM, where the size
 // and addresses are defined in settings.h. With the current settings, up to 2 startup blocks may
@@ -101,6 +108,84 @@
 #define RAPID_OVERRIDE_MEDIUM    50 // Percent of rapid (1-99). Usually 50%.
 #define RAPID_OVERRIDE_LOW       25 // Percent of rapid (1-99). Usually 25%.
 
+// By default, every feed or rapid override change re-computes the nominal speeds of the entire planner
+// buffer and re-plans it from the executing block. When an operator turns an override knob, these
+// back-to-back re-plans can keep the main program from refilling the step segment buffer. This option
+// defers the re-plan. The executing block picks up the new override right away, with its exit speed
+// limited to the new nominal speed, while the rest of the buffer is re-planned once, when the segment
+// generator loads the next block. Any number of override changes then costs at most one re-plan per
+// executed block.
+// #define ENABLE_LAZY_OVERRIDE_REPLAN // Default disabled. Uncomment to enable.
+
+// Enables continuous overrides and the override slew rate setting ($14). The CMD_FEED_OVR_SET and
+// CMD_RAPID_OVR_SET realtime commands are followed by a byte of the new override value in percent,
+// which is limited to the allowable range, so a pendant may track a knob without a series of steps.
+// NOTE: The value byte is never treated as a realtime command, whatever character it is.
+// The executed overrides slew to any new value at the override slew rate in percent per second, such
+// that the executed speed changes over a bounded time and within the block acceleration. A zero rate
+// applies override changes immediately, as without this option.
+// #define ENABLE_CONTINUOUS_OVERRIDES // Default disabled. Uncomment to enable.
+
+// Enables streaming of host-computed step segments, which bypass the g-code parser, the planner and
+// the segment preparation. The host sends binary frames, each starting with the CMD_SEGMENT_BLOCK or
+// CMD_SEGMENT character, which are queued directly in the segment buffer and replied to with an 'ok'.
+// A block frame holds the direction mask (bit set for negative axis direction) and the unsigned step
+// counts of each axis as little-endian 32-bit values. A segment frame holds the 16-bit number of step
+// events and the 32-bit CPU cycles per step event of a segment of the last block. Grbl applies AMASS
+// or the timer prescaler, as for planned segments. See doc/script/stream_segments.py for an encoder.
+// Any text line, such as an empty line, ends the streamed motion, waits for it to complete and syncs
+// the g-code and planner positions to the machine position.
+// NOTE: Streamed segments start immediately and are not subject to overrides or deceleration. A feed
+// hold or an underrun of the segment buffer stops them abruptly. Realtime commands other than a reset
+// are not recognized within a frame. A reset drops a partly received frame, so frame data bytes equal
+// to CMD_RESET or CMD_FRAME_ESCAPE must be sent escaped by a preceding CMD_FRAME_ESCAPE. This applies
+// to the frames of all binary streaming options.
+// #define ENABLE_SEGMENT_STREAMING // Default disabled. Uncomment to enable.
+
+// Enables streaming of host-planned blocks, which bypass the g-code parser and the junction speed
+// computations. A host that plans the whole program sends each block as a binary frame, starting with
+// the CMD_PLANNED_BLOCK character and replied to with an 'ok'. The frame holds the signed step counts of
+// each axis as little-endian 32-bit integers, followed by little-endian 32-bit floats of the distance
+// (mm), the acceleration (mm/min^2), the programmed rate and the rapid rate (mm/min), the maximum entry
+// speed, the planned entry speed and the planned exit speed (all (mm/min)^2), and a condition byte,
+// where bit 0 flags a rapid motion. The programmed rate is subject to overrides as usual. Grbl plans the
+// entry speeds within the lower of the maximum and planned entry speeds, and of the planned exit speed
+// of a preceding host-planned block. The last block in the buffer is still planned to a stop, so feed
+// holds and a host that can't keep up always stop in a controlled manner. Host-planned and g-code
+// motions may be mixed, where the host plans a stop at either end. Frame data bytes are escaped as for
+// segment streaming. The stream_segments.py script in doc/script encodes these frames with the '-b' option.
+// NOTE: Host-planned blocks execute constant acceleration ramps.
+// #define ENABLE_PREPLANNED_BLOCKS // Default disabled. Uncomment to enable.
+
+// Enables binary motion blocks alongside text g-code, which skip the text parsing and number
+// conversion of the g-code parser, and take about a third fewer serial bytes than motion lines with
+// three decimal coordinates. A frame starts with the CMD_BINARY_BLOCK character, followed by a motion
+// byte, a word mask byte and a little-endian 32-bit float per word set in the mask. The motion byte
+// selects G0, G1, G2 or G3 by the values 1 to 4, or zero to keep the modal motion. The word mask bits
+// are, from bit 0, the axis words (X,Y,Z), the arc offset words (I,J,K) of the configured axes, and
+// the R and F words. Each frame is executed as the equivalent g-code line with the active modal state,
+// and replied to with an 'ok' or the same error codes. So a frame of only an F word changes the feed
+// rate. Realtime commands are single characters as usual. Within a frame, only a reset is recognized
+// and data bytes are escaped as for segment streaming. See doc/script/stream_binary.py for an encoder.
+// #define ENABLE_BINARY_PROTOCOL // Default disabled. Uncomment to enable.
+
+// Enables a fast path of the g-code parser for plain linear motion lines, such as 'G1X10Y20' or 'X10Y20'
+// under a modal G0/G1. Lines with only axis words and optional G0/G1, F and N words are executed
+// without the block struct setup and the modal group and value word checks of the full parser, in G94
+// feed rate mode. All other lines and any line with an error are passed to the full parser, so the
+// motions and error codes are the same. 'make bench' in doc/script/host counts the lines per second
+// of both parsers on the host.
+// #define ENABLE_LINEAR_FAST_PATH // Default disabled. Uncomment to enable.
+
+// Enables fixed-point coordinates for linear motions. Axis words are parsed directly into integers of
+// 0.0001mm, work coordinate offsets are applied in integer and the targets are converted to steps with
+// an exact rational steps/mm factor, instead of float math. The parser position of G0/G1 motions is
+// then exact, such that long incremental (G91) programs do not accumulate float rounding errors. Axis
+// words are limited to +/-100000mm. Steps/mm settings with more than three decimals, or too large a
+// rational factor, are converted to steps in float as usual. Arcs still use float math. 'make bench'
+// in doc/script/host counts the lines per second with and without fixed-point coordinates on the host.
+// #define ENABLE_FIXED_POINT_COORDINATES // Default disabled. Uncomment to enable.
+
 // When a M2 or M30 program end command is executed, most g-code states are restored to their defaults.
 // This compile-time option includes the restoring of the feed and rapi override values
 // to their default values at program end.
@@ -141,6 +226,30 @@
 // certain the step segment buffer is increased/decreased to account for these changes.
 #define ACCELERATION_TICKS_PER_SECOND 100
 
+// Sets the execution time of step segments at a constant speed as a multiple of the acceleration tick
+// time above. Acceleration and deceleration ramps require short segments to update the velocity,
+// while cruising segments do not. Longer cruising segments reduce the segment generator CPU load at
+// high feed rates, freeing up time for parsing and planning. Line motions only. Arc segments are
+// chords of the arc and are kept short.
+// NOTE: The segment buffer holds more execution time when cruising, which delays the response to feed
+// holds and overrides by up to SEGMENT_BUFFER_SIZE-1 cruising segments. Keep this value small.
+// #define CRUISE_SEGMENT_TIME_MULTIPLIER 4 // Default disabled. Uncomment to enable. Integer (2-8)
+
+// Sets the execution time of step segments starting in an acceleration or deceleration ramp as a
+// fraction of the acceleration tick time above. Shorter ramp segments update the velocity more often,
+// which follows the planned velocity profile more closely at the cost of more segments per second.
+// Cruising segments are unaffected, so this pairs with CRUISE_SEGMENT_TIME_MULTIPLIER to pick the
+// segment time by ramp state.
+// NOTE: The segment buffer holds less execution time during ramps, and the segment generator must
+// keep up with the shorter segments. Keep this value small, or raise SEGMENT_BUFFER_SIZE.
+// #define RAMP_SEGMENT_TIME_DIVISOR 2 // Default disabled. Uncomment to enable. Integer (2-4)
+
+// Caches the step timing of step segments at a constant speed. All full segments of a cruise execute
+// the same step rate, so once cached, the segment generator only advances the distance and the step
+// counts of the following segments, skipping the velocity profile and step timing computations until
+// the end of the cruise. Frees up CPU time for parsing and planning during long constant speed motions.
+// #define ENABLE_CRUISE_SEGMENT_CACHE // Default disabled. Uncomment to enable.
+
 // Adaptive Multi-Axis Step Smoothing (AMASS) is an advanced feature that does what its name implies,
 // smoothing the stepping of multi-axis motions. This feature smooths motion particularly at low step
 // frequencies below 10kHz, where the aliasing between axes of multi-axis motions can cause audible
@@ -148,6 +257,32 @@
 // step smoothing. See stepper.c for more details on the AMASS system works.
 #define ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING  // Default enabled. Comment to disable.
 
+// Enables jerk-limited (S-curve) velocity profiles. With the standard trapezoidal profiles, the
+// acceleration steps instantly at the start and end of every ramp, which can excite ringing in light
+// or tall gantries. With this option, the segment generator shapes each planned ramp as an S-curve,
+// where the acceleration rises and falls linearly with time, limited by the per-axis jerk settings
+// ($140, $141, ...). Each S-curve ramp takes the same time and distance as the constant acceleration
+// ramp the planner computed, so the look-ahead plan and junction speeds are unchanged. To not exceed
+// the axis acceleration settings at the peak of the S-curve, the planner plans each block with the
+// average acceleration of a jerk-limited ramp from rest to the block's programmed rate, which is lower
+// than the acceleration setting. Shorter ramps honor the acceleration settings, but may exceed the jerk
+// limit in proportion. Setting a jerk value to zero restores trapezoidal profiles for motions using
+// that axis.
+// NOTE: Requires additional flash and a few floating point computations per step segment.
+// #define ENABLE_JERK_LIMITED_PROFILES // Default disabled. Uncomment to enable.
+
+// Computes the step counts and step timing of each step segment with fixed-point integer math,
+// instead of floating point. The AVR has no floating point hardware, and the divides and round-up
+// operations of the float version are slow, which adds up with short segments and blocks. Only the
+// step count and step timing math is fixed-point. The velocity profile ramps are still computed in
+// float, and the speed gain on the AVR has not been measured. Step distances are tracked with 1/256
+// step resolution in an int32, which limits planner blocks to 8388607 steps per axis. Longer lines
+// and arcs are split, as for compact planner blocks. The steps of each segment are the same as the
+// float version, while the step timing differs only by the 1/256 step resolution of the partial step
+// carried between segments. 'make test' in doc/script/host checks this against the float version on
+// the host.
+// #define USE_FIXED_POINT_SEGMENT_PREP // Default disabled. Uncomment to enable.
+
 // Sets the maximum step rate allowed to be written as a Grbl setting. This option enables an error
 // check in the settings module to prevent settings values that will exceed this limitation. The maximum
 // step rate is strictly limited by the CPU speed and will change if something other than an AVR running
@@ -155,6 +290,54 @@
 // NOTE: For now disabled, will enable if flash space permits.
 // #define MAX_STEP_RATE_HZ 30000 // Hz
 
+// Counts the steps of the executing step segment per axis in the stepper driver interrupt, instead of
+// updating the 32-bit machine position on every step. The counts are added to the machine position
+// when the segment completes or the steppers go idle, and the status report adds the counts of the
+// executing segment. This removes the 32-bit arithmetic and direction checks of every step from the
+// interrupt, which raises the maximum step rate.
+// #define USE_SEGMENT_POSITION_COUNTERS // Default disabled. Uncomment to enable.
+
+// Executes 2 or 4 step events per stepper driver interrupt above STEP_BURST_FREQUENCY, to exceed the
+// interrupt rate limit of about 30kHz. The first step pulse of a tick is output as usual, and the
+// others follow in a pulse train timed within the interrupt. Each pulse lasts the step pulse time
+// setting ($0) and pins stay low for STEP_BURST_LOW_TIME between pulses. Bursts of 2 steps start at
+// the burst frequency and bursts of 4 at twice that, so the interrupt rate stays at or below the burst
+// frequency up to 4 times it. Above that, the interrupt rate rises again with the step rate.
+// NOTE: The interrupt spins through the pulse train, which is limited to half of a tick. Bursts that do
+// not fit are shortened to 2 steps or none, which raises the interrupt rate. At the default $0=10, 4-step
+// bursts fit up to 55kHz and 2-step bursts up to 83kHz, at an interrupt rate of up to 42kHz. Use the
+// shortest step pulse time the drivers allow. With $0=3, 4-step bursts fit up to 133kHz.
+// The steps of a burst are evenly spaced only within the train. Requires high-resolution microstepping
+// drivers that tolerate this. Not supported with STEP_PULSE_DELAY or dual axis.
+// #define ENABLE_STEP_BURST // Default disabled. Uncomment to enable.
+#define STEP_BURST_FREQUENCY 20000 // Step frequency to start bursts of 2 steps (Hz). Must be > 16000 with AMASS.
+#define STEP_BURST_LOW_TIME 2 // Step pin low time between the pulses of a burst (usec)
+
+// Profiles the execution time of the stepper driver interrupt, to find the true maximum step rate of
+// a configuration. Timer2 runs free at 1/8 prescaler and is read at interrupt entry and exit. The
+// minimum, average and maximum times are printed in microseconds by the '$P' command, along with the
+// interrupt count, the overruns and the re-entries. An overrun is an interrupt that does not finish
+// before the next one is due, including re-entries skipped by the busy flag. '$PR' clears the profile.
+// NOTE: Uses Timer2. Times wrap around at 128usec on a 16MHz AVR. The profiling adds about 2usec to
+// every interrupt, which is included in the times. The average stops after about 2^32 ticks of 0.5usec
+// (over half an hour at 100% load), and the overrun and re-entry counts saturate at 65535.
+// #define ENABLE_STEPPER_ISR_PROFILE // Default disabled. Uncomment to enable.
+
+// Records main loop telemetry, to tell why the step segment buffer runs dry during a job. The '$L'
+// command prints '[TLM:latency,line max,line avg,lines,starvations,low water]' and '$LR' clears it.
+// - Latency: Longest time between step segment buffer refills in a cycle, in microseconds. This is
+//   the worst main loop latency, as the buffer is refilled at every realtime check point.
+// - Line max/avg: Execution time of g-code lines in microseconds. Realtime command execution and
+//   waiting for room in the planner buffer are excluded, while G4 dwells are included.
+// - Lines: Number of g-code lines timed.
+// - Starvations: Times the step segment buffer ran empty in a cycle, while the planner still had
+//   blocks. Long latencies or lines then point to a CPU-bound stall.
+// - Low water: Fewest blocks in the planner buffer when re-planned in a cycle. A low value without
+//   starvations points to the serial stream not keeping up.
+// NOTE: Uses Timer2 and its overflow interrupt. Shares Timer2 with ENABLE_STEPPER_ISR_PROFILE, which
+// sets a 1/8 prescaler that limits timed intervals to 8 seconds. Otherwise, the limit is 67 seconds.
+// #define ENABLE_MAIN_LOOP_TELEMETRY // Default disabled. Uncomment to enable.
+
 // With this enabled, Grbl sends back an echo of the line it has received, which has been pre-parsed (spaces
 // removed, capitalized letters, no comments) and is to be immediately executed by Grbl. Echoes will not be
 // sent upon a line buffer overflow, but should for all normal lines sent to Grbl. For example, if a user
@@ -172,18 +355,87 @@
 // should not be much greater than zero or to the minimum value necessary for the machine to work.
 #define MINIMUM_JUNCTION_SPEED 0.0 // (mm/min)
 
+// Computes the junction speed of each new block with a small table instead of the exact trigonometric
+// formula, which saves a square root and a division per block on the AVR and raises the streaming
+// rate of dense G1 programs. The table size sets the error bound. The table entries are rounded down
+// and interpolated over a concave function, so the table value never exceeds the exact junction
+// factor of the same float inputs, and junction speeds err low. Only the float round-off of the
+// direction change, which the exact formula has as well, may raise them above the exact value, by
+// less than 0.01%. With 16 entries, they are at most 0.11% lower for direction changes up to 120
+// degrees and 1.2% lower up to 150 degrees. Sharper corners, which are nearly stopped at anyway, are
+// slowed further. Each doubling of the table size roughly quarters the error. The table is computed
+// at compile time and uses 2 bytes of flash per entry. The accuracy is checked against the exact
+// formula in double precision by 'make test' in doc/script/host.
+// #define JUNCTION_FACTOR_TABLE_SIZE 16 // Default disabled. Uncomment to enable. Integer (4-128)
+
 // Sets the minimum feed rate the planner will allow. Any value below it will be set to this minimum
 // value. This also ensures that a planned motion always completes and accounts for any floating-point
 // round-off errors. Although not recommended, a lower value than 1.0 mm/min will likely work in smaller
 // machines, perhaps to 0.1mm/min, but your success may vary based on multiple factors.
 #define MINIMUM_FEED_RATE 1.0 // (mm/min)
 
+// Enables merging of nearly collinear line motions in the planner buffer. CAM programs often contain
+// long runs of tiny line motions along a smooth path, each taking up a planner block, which limits the
+// look-ahead distance and the speed of the machine. When enabled, a new line motion is merged with the
+// last queued one into a single line, if the direction changes by no more than BLOCK_MERGE_MAX_ANGLE
+// and the programmed path deviates from the merged line by no more than BLOCK_MERGE_TOLERANCE. Only
+// motions with the same motion mode and feed rate are merged, and never into the executing block.
+// NOTE: Merged motions report the line number of the first one, so motions with different line
+// numbers are not merged when USE_LINE_NUMBERS is enabled.
+// #define ENABLE_BLOCK_MERGING // Default disabled. Uncomment to enable.
+#define BLOCK_MERGE_TOLERANCE 0.002 // Maximum path deviation of merged motions (mm). Float (0.0-0.01)
+#define BLOCK_MERGE_MAX_ANGLE 0.1 // Maximum direction change of merged motions (radians). Float (0.0-0.5)
+
+// Enables the G64 P path blending mode. In G64, the corner between two consecutive G1 motions with the
+// same feed rate is rounded with a tangent arc, which deviates from the programmed corner by at most
+// the P tolerance (mm), so the corner is taken near the programmed feed rate instead of slowing down
+// to the junction deviation speed. G64 without P uses the junction deviation setting as tolerance.
+// A blend arc takes at most half of either motion. Only corners in the XY plane are blended, and only
+// while the earlier motion is still queued in the planner buffer. G61 restores exact path mode.
+// NOTE: With line numbers, the shortened earlier motion keeps its line number, and the blend arc
+// reports the line number of the following motion.
+// #define ENABLE_PATH_BLENDING // Default disabled. Uncomment to enable.
+
 // Number of arc generation iterations by small angle approximation before exact arc trajectory
 // correction with expensive sin() and cos() calcualtions. This parameter maybe decreased if there
 // are issues with the accuracy of the arc generations, or increased if arc execution is getting
 // bogged down by too many trig calculations.
 #define N_ARC_CORRECTION 12 // Integer (1-255)
 
+// Enables native arc blocks in the planner. By default, G2/G3 arcs are chopped into many short line
+// motions, one per planner block, sized by the arc tolerance ($12). Short arc segments quickly fill
+// the planner buffer, which limits the look-ahead distance and slows down arcs, and each segment costs
+// the planning overhead of a full line motion. With this option, an arc is queued as a single planner
+// block, storing its center, angular travel, and helical travel. The step segment generator traces
+// the arc as it executes, computing each step segment as a short line to the next point on the arc.
+// The arc tolerance ($12) limits the length of these step segments instead, which are shortened at
+// high speeds, such that their chords stay within the tolerance. Arc speeds are limited by the
+// centripetal acceleration allowed by the axis acceleration settings.
+// NOTE: Each planner block requires 14 more bytes of RAM. The planner buffer size may need to be
+// reduced to fit in the Arduino 328p RAM.
+// #define ENABLE_NATIVE_ARC_BLOCKS // Default disabled. Uncomment to enable.
+
+// Generates the line segments of G2/G3 arcs incrementally from the main loop. By default, an arc is
+// chopped into all of its line segments at once, and the parser waits on every full planner buffer
+// until the last segment is queued. With this option, the arc generator keeps its state and stops as
+// soon as the planner buffer is full. It then resumes from the main loop each time planner blocks are
+// freed, such that status reports and real-time commands are serviced promptly and each main loop pass
+// does a bounded amount of arc work. The next motion command finishes any remaining arc segments first.
+// NOTE: Not compatible with ENABLE_NATIVE_ARC_BLOCKS, which does not chop arcs into line segments.
+// #define ENABLE_INCREMENTAL_ARCS // Default disabled. Uncomment to enable.
+
+// Limits the feed rate of G2/G3 arcs such that their line segments are not executed faster than the
+// planner and stepper can take them. The arc tolerance ($12) still sets the segment length, which is
+// short on small radii. At high feed rates, such segments take less time to execute than to plan, and
+// each planner block needs at least one step segment, so the buffers run dry and the machine stutters.
+// With this option, the arc feed rate is lowered when a segment would take less than
+// ARC_MIN_SEGMENT_TIME to execute. The junction speed limit of the planner is accounted for, such that
+// arcs already slowed down by the acceleration settings are left as is.
+// NOTE: Feed overrides above 100% may still exceed the segment time limit. Not compatible with
+// ENABLE_NATIVE_ARC_BLOCKS, which does not chop arcs into line segments.
+// #define ENABLE_ADAPTIVE_ARC_SEGMENTS // Default disabled. Uncomment to enable.
+#define ARC_MIN_SEGMENT_TIME 10 // Integer (milliseconds). One step segment at ACCELERATION_TICKS_PER_SECOND.
+
 // The arc G2/3 g-code standard is problematic by definition. Radius-based arcs have horrible numerical
 // errors when arc at semi-circles(pi) or full-circles(2*pi). Offset-based arcs are much more accurate
 // but still have a problem when arcs are full-circles (2*pi). This define accounts for the floating
@@ -219,6 +471,28 @@
 // new incoming motions as they are executed.
 // #define BLOCK_BUFFER_SIZE 16 // Uncomment to override default in planner.h.
 
+// Stores planner blocks in a compact form to fit more of them in the same RAM. Step counts are kept
+// as 16-bit values and the junction speed and rapid rate limits as whole mm/min, rounded down and
+// capped at 65535mm/min. Line motions longer than 65535 steps on any axis are split into equal parts,
+// which are executed without slowing down between them. The default BLOCK_BUFFER_SIZE in planner.h
+// is raised to use about the same RAM as the default buffer of regular blocks.
+// #define USE_COMPACT_PLANNER_BLOCKS // Default disabled. Uncomment to enable.
+
+// Stores the velocity profile data of the planner blocks, which are the only fields used by the planner
+// passes, in a separate array instead of within each block. The passes then walk a dense array, which
+// may only help ports to processors with a small data cache and long planner buffers. The AVR has no
+// data cache, so it gains nothing. On a desktop processor, 'make bench' in doc/script/host measures
+// no gain up to 250 blocks either, since the whole buffer stays in the cache.
+// #define USE_SPLIT_PLANNER_PROFILES // Default disabled. Uncomment to enable.
+
+// Adds a small queue of parsed line motions between the g-code parser and the planner buffer. When the
+// planner buffer is full, line motions are queued instead of blocking the parser, such that the next
+// lines are received and parsed while the machine moves. Queued motions enter the planner in order, as
+// soon as it has room. The parser only waits when the queue is full as well. Each queued motion takes
+// up to about 40 bytes of RAM.
+// #define ENABLE_PARSE_AHEAD_QUEUE // Default disabled. Uncomment to enable.
+// #define PARSE_AHEAD_QUEUE_SIZE 4 // Uncomment to override default in motion_control.h.
+
 // Governs the size of the intermediary step segment buffer between the step execution algorithm
 // and the planner blocks. Each segment is set of steps executed at a constant velocity over a
 // fixed time defined by ACCELERATION_TICKS_PER_SECOND. They are computed such that the planner
@@ -369,7 +643,10 @@
 #define SERIAL_RX     USART_RX_vect
 #define SERIAL_UDRE   USART_UDRE_vect
 
-// Number of Axis
+// Number of Axis. Up to 6 axes (X,Y,Z,A,B,C). Each axis requires its step and direction bits below,
+// from which the stepper code and pin masks are generated, and its default settings. G-code words
+// exist for X, Y and Z only, so the A, B and C axes are only moved by host-planned blocks. See
+// ENABLE_PREPLANNED_BLOCKS.
 #define N_AXIS 2
 
 // Define step pulse output pins. NOTE: All step bit pins must be on the same port.
@@ -377,24 +654,20 @@
 #define STEP_PORT       PORTD
 #define X_STEP_BIT      5  // Uno Digital Pin 5
 #define Y_STEP_BIT      7  // Uno Digital Pin 7
-#ifdef Z_AXIS
+#if N_AXIS > 2
   #define Z_STEP_BIT      6  // Uno Digital Pin 6
-  #define STEP_MASK       ((1<<X_STEP_BIT)|(1<<Y_STEP_BIT)|(1<<Z_STEP_BIT)) // All step bits
-#else
-  #define STEP_MASK       ((1<<X_STEP_BIT)|(1<<Y_STEP_BIT)) // All step bits
 #endif
+#define STEP_MASK       (0 AXIS_TABLE(AXIS_STEP_PIN_BIT)) // All step bits
 
 // Define step direction output pins. NOTE: All direction pins must be on the same port.
 #define DIRECTION_DDR     DDRD
 #define DIRECTION_PORT    PORTD
 #define X_DIRECTION_BIT   2  // Uno Digital Pin 2
 #define Y_DIRECTION_BIT   4  // Uno Digital Pin 4
-#ifdef Z_AXIS
+#if N_AXIS > 2
   #define Z_DIRECTION_BIT   3  // Uno Digital Pin 3
-  #define DIRECTION_MASK    ((1<<X_DIRECTION_BIT)|(1<<Y_DIRECTION_BIT)|(1<<Z_DIRECTION_BIT)) // All direction bits
-#else
-#define DIRECTION_MASK    ((1<<X_DIRECTION_BIT)|(1<<Y_DIRECTION_BIT)) // All direction bits
 #endif
+#define DIRECTION_MASK    (0 AXIS_TABLE(AXIS_DIRECTION_PIN_BIT)) // All direction bits
 
 // Define stepper driver enable/disable output pin.
 #define STEPPERS_DISABLE_DDR    DDRB
@@ -407,15 +680,33 @@
 #define DEFAULT_X_STEPS_PER_MM 200.0 // steps/rotation
 #define DEFAULT_Y_STEPS_PER_MM 200.0 // steps/rotation
 #define DEFAULT_Z_STEPS_PER_MM 200.0 // steps/rotation
+#define DEFAULT_A_STEPS_PER_MM 200.0 // steps/rotation
+#define DEFAULT_B_STEPS_PER_MM 200.0 // steps/rotation
+#define DEFAULT_C_STEPS_PER_MM 200.0 // steps/rotation
 #define DEFAULT_X_MAX_RATE 500.0 // rpm
 #define DEFAULT_Y_MAX_RATE 500.0 // rpm
 #define DEFAULT_Z_MAX_RATE 500.0 // rpm
+#define DEFAULT_A_MAX_RATE 500.0 // rpm
+#define DEFAULT_B_MAX_RATE 500.0 // rpm
+#define DEFAULT_C_MAX_RATE 500.0 // rpm
 #define DEFAULT_X_ACCELERATION (10.0*60*60) // 10*60*60 rot/min^2 = 10 rot/sec^2
 #define DEFAULT_Y_ACCELERATION (10.0*60*60) // 10*60*60 rot/min^2 = 10 rot/sec^2
 #define DEFAULT_Z_ACCELERATION (10.0*60*60) // 10*60*60 rot/min^2 = 10 rot/sec^2
+#define DEFAULT_A_ACCELERATION (10.0*60*60) // 10*60*60 rot/min^2 = 10 rot/sec^2
+#define DEFAULT_B_ACCELERATION (10.0*60*60) // 10*60*60 rot/min^2 = 10 rot/sec^2
+#define DEFAULT_C_ACCELERATION (10.0*60*60) // 10*60*60 rot/min^2 = 10 rot/sec^2
+#define DEFAULT_X_JERK (100.0*60*60*60) // 100*60*60*60 rot/min^3 = 100 rot/sec^3
+#define DEFAULT_Y_JERK (100.0*60*60*60) // 100*60*60*60 rot/min^3 = 100 rot/sec^3
+#define DEFAULT_Z_JERK (100.0*60*60*60) // 100*60*60*60 rot/min^3 = 100 rot/sec^3
+#define DEFAULT_A_JERK (100.0*60*60*60) // 100*60*60*60 rot/min^3 = 100 rot/sec^3
+#define DEFAULT_B_JERK (100.0*60*60*60) // 100*60*60*60 rot/min^3 = 100 rot/sec^3
+#define DEFAULT_C_JERK (100.0*60*60*60) // 100*60*60*60 rot/min^3 = 100 rot/sec^3
 #define DEFAULT_X_MAX_TRAVEL 200.0 // rotations
 #define DEFAULT_Y_MAX_TRAVEL 200.0 // rotations
 #define DEFAULT_Z_MAX_TRAVEL 200.0 // rotations
+#define DEFAULT_A_MAX_TRAVEL 200.0 // rotations
+#define DEFAULT_B_MAX_TRAVEL 200.0 // rotations
+#define DEFAULT_C_MAX_TRAVEL 200.0 // rotations
 #define DEFAULT_STEP_PULSE_MICROSECONDS 10
 #define DEFAULT_STEPPING_INVERT_MASK 0
 #define DEFAULT_DIRECTION_INVERT_MASK 0
@@ -423,6 +714,7 @@
 #define DEFAULT_STATUS_REPORT_MASK 1 // MPos enabled
 #define DEFAULT_JUNCTION_DEVIATION 0.01 // mm
 #define DEFAULT_ARC_TOLERANCE 0.002 // mm
+#define DEFAULT_OVERRIDE_SLEW_RATE 100.0 // percent/sec
 #define DEFAULT_INVERT_ST_ENABLE 0 // false
 
 #endif
@@ -37,6 +37,29 @@ parser_block_t gc_block;
 #define FAIL(status) return(status);
 
 
+#ifdef ENABLE_FIXED_POINT_COORDINATES
+  // Converts a coordinate system to fixed-point units, including the coordinate offset.
+  static void gc_convert_coord_to_fixed(int32_t *coord_fixed, float *coord_system)
+  {
+    uint8_t idx;
+    for (idx=0; idx<N_AXIS; idx++) {
+      coord_fixed[idx] = lround((coord_system[idx]+gc_state.coord_offset[idx])*FIXED_POINT_SCALE);
+    }
+  }
+
+
+  // Sets the planner data of a linear motion to the fixed-point target converted to steps, and the
+  // target in mm to the fixed-point target for all other uses, like the parser position.
+  static void gc_set_step_target(float *target, int32_t *target_fixed, plan_line_data_t *pl_data)
+  {
+    system_convert_array_fixed_to_steps(pl_data->target_steps, target_fixed);
+    pl_data->condition |= PL_COND_FLAG_STEP_TARGET;
+    uint8_t idx;
+    for (idx=0; idx<N_AXIS; idx++) { target[idx] = target_fixed[idx]*(1.0/FIXED_POINT_SCALE); }
+  }
+#endif
+
+
 void gc_init()
 {
   memset(&gc_state, 0, sizeof(parser_state_t));
@@ -45,6 +68,9 @@ void gc_init()
   if (!(settings_read_coord_data(gc_state.modal.coord_select,gc_state.coord_system))) {
     report_status_message(STATUS_SETTING_READ_FAIL);
   }
+  #ifdef ENABLE_FIXED_POINT_COORDINATES
+    gc_convert_coord_to_fixed(gc_state.coord_fixed, gc_state.coord_system);
+  #endif
 }
 
 
@@ -53,9 +79,124 @@ void gc_init()
 void gc_sync_position()
 {
   system_convert_array_steps_to_mpos(gc_state.position,sys_position);
+  #ifdef ENABLE_FIXED_POINT_COORDINATES
+    gc_sync_position_fixed();
+  #endif
 }
 
 
+#ifdef ENABLE_FIXED_POINT_COORDINATES
+  // Sets g-code parser fixed-point position from the position in mm. Called whenever the position is
+  // not updated by a fixed-point target, such as after arcs and jogs.
+  void gc_sync_position_fixed()
+  {
+    uint8_t idx;
+    for (idx=0; idx<N_AXIS; idx++) { gc_state.position_fixed[idx] = lround(gc_state.position[idx]*FIXED_POINT_SCALE); }
+  }
+#endif
+
+
+#ifdef ENABLE_LINEAR_FAST_PATH
+  // Executes a plain linear motion line, which holds only axis words and optional G0/G1, F and N words,
+  // under the G94 feed rate mode. Skips the block struct setup and the modal group and value word
+  // checks of the full parser, which only apply to the other commands and words. The target, planner
+  // data and parser state are the same as computed by the full parser. Returns false without any
+  // changes, if the line needs the full parser, which then also reports any errors.
+  static uint8_t gc_execute_linear_line(char *line)
+  {
+    if (gc_state.modal.feed_rate != FEED_RATE_MODE_UNITS_PER_MIN) { return(false); }
+
+    uint8_t motion = gc_state.modal.motion;
+    float feed_rate = gc_state.feed_rate;
+    int32_t line_number = 0; // Zero, if no line number is present.
+    float target[N_AXIS];
+    #ifdef ENABLE_FIXED_POINT_COORDINATES
+      int32_t target_fixed[N_AXIS];
+    #endif
+    uint8_t words = 0; // Tracks the words of the line. Axis words by axis index.
+    uint8_t word_bit;
+    uint8_t char_counter = 0;
+    uint8_t idx;
+    char letter;
+    float value;
+    while ((letter = line[char_counter]) != 0) {
+      char_counter++;
+      idx = letter-'X';
+      if (idx < N_WORD_AXIS) { // Axis word. X, Y and Z are consecutive letters.
+        #ifdef ENABLE_FIXED_POINT_COORDINATES
+          if (!read_fixed(line, &char_counter, &target_fixed[idx])) { return(false); }
+        #else
+          if (!read_float(line, &char_counter, &target[idx])) { return(false); }
+        #endif
+        word_bit = bit(idx);
+      } else {
+        if (!read_float(line, &char_counter, &value)) { return(false); }
+        switch (letter) {
+          case 'G':
+            // Only exact G0 and G1 values, as MOTION_MODE_SEEK and MOTION_MODE_LINEAR.
+            if ((value != 0.0) && (value != 1.0)) { return(false); }
+            motion = value; word_bit = bit(N_WORD_AXIS); break;
+          case 'F':
+            if (value < 0.0) { return(false); }
+            feed_rate = value; word_bit = (bit(N_WORD_AXIS) << 1); break;
+          case 'N':
+            if (value < 0.0) { return(false); }
+            line_number = trunc(value); word_bit = (bit(N_WORD_AXIS) << 2);
+            if (line_number > MAX_LINE_NUMBER) { return(false); }
+            break;
+          default: return(false);
+        }
+      }
+      if (words & word_bit) { return(false); } // Repeated word
+      words |= word_bit;
+    }
+    // Requires axis words under G0, or G1 with a defined feed rate. Otherwise, the motion is not
+    // executed or it is an error.
+    if (!(words & (bit(N_WORD_AXIS)-1))) { return(false); }
+    if (motion == MOTION_MODE_LINEAR) {
+      if (feed_rate == 0.0) { return(false); }
+    } else if (motion != MOTION_MODE_SEEK) { return(false); }
+
+    for (idx=0; idx<N_AXIS; idx++) {
+      #ifdef ENABLE_FIXED_POINT_COORDINATES
+        if ((idx >= N_WORD_AXIS) || bit_isfalse(words,bit(idx))) { target_fixed[idx] = gc_state.position_fixed[idx]; }
+        else if (gc_state.modal.distance == DISTANCE_MODE_ABSOLUTE) { target_fixed[idx] += gc_state.coord_fixed[idx]; }
+        else { target_fixed[idx] += gc_state.position_fixed[idx]; }
+      #else
+        if ((idx >= N_WORD_AXIS) || bit_isfalse(words,bit(idx))) { target[idx] = gc_state.position[idx]; }
+        else if (gc_state.modal.distance == DISTANCE_MODE_ABSOLUTE) {
+          target[idx] += gc_state.coord_system[idx] + gc_state.coord_offset[idx];
+        } else { target[idx] += gc_state.position[idx]; }
+      #endif
+    }
+
+    plan_line_data_t plan_data;
+    memset(&plan_data,0,sizeof(plan_line_data_t)); // Zero plan_data struct
+    gc_state.line_number = line_number;
+    #ifdef USE_LINE_NUMBERS
+      plan_data.line_number = line_number;
+    #endif
+    gc_state.feed_rate = feed_rate;
+    plan_data.feed_rate = feed_rate;
+    gc_state.modal.motion = motion;
+    if (motion == MOTION_MODE_SEEK) { plan_data.condition |= PL_COND_FLAG_RAPID_MOTION; }
+    #ifdef ENABLE_PATH_BLENDING
+      else if (gc_state.modal.control == CONTROL_MODE_BLEND) { plan_data.blend_tolerance = gc_state.blend_tolerance; }
+    #endif
+    #ifdef ENABLE_FIXED_POINT_COORDINATES
+      gc_set_step_target(target, target_fixed, &plan_data);
+      memcpy(gc_state.position_fixed, target_fixed, sizeof(target_fixed)); // gc_state.position_fixed[] = target_fixed[]
+    #endif
+    #ifdef ENABLE_INCREMENTAL_ARCS
+      mc_finish_arc(); // Queue any remaining arc segments first.
+    #endif
+    mc_line(target, &plan_data);
+    memcpy(gc_state.position, target, sizeof(target)); // gc_state.position[] = target[]
+    return(true);
+  }
+#endif
+
+
 // Executes one line of 0-terminated G-Code. The line is assumed to contain only uppercase
 // characters and signed floating point values (no whitespace). Comments and block delete
 // characters have been removed. In this function, all units and positions are converted and
@@ -63,6 +204,10 @@ void gc_sync_position()
 // coordinates, respectively.
 uint8_t gc_execute_line(char *line)
 {
+  #ifdef ENABLE_LINEAR_FAST_PATH
+    if (gc_execute_linear_line(line)) { return(STATUS_OK); }
+  #endif
+
   /* -------------------------------------------------------------------------------------
      STEP 1: Initialize parser block struct and copy current g-code state modes. The parser
      updates these modes and commands as the block line is parser and will only be used and
@@ -74,7 +219,14 @@ uint8_t gc_execute_line(char *line)
   memcpy(&gc_block.modal,&gc_state.modal,sizeof(gc_modal_t)); // Copy current modes
 
   uint8_t axis_command = AXIS_COMMAND_NONE;
-  uint8_t axis_0, axis_1, axis_linear;
+  // Arcs are always in the XY-plane (G17). Plane selection is not supported.
+  uint8_t axis_0 = X_AXIS;
+  uint8_t axis_1 = Y_AXIS;
+  #ifdef Z_AXIS
+    uint8_t axis_linear = Z_AXIS;
+  #else
+    uint8_t axis_linear = N_AXIS; // No helical axis.
+  #endif
   uint8_t coord_select = 0; // Tracks G10 P coordinate selection for execution
 
   // Initialize bitflag tracking variables for axis indices compatible operations.
@@ -112,12 +264,63 @@ uint8_t gc_execute_line(char *line)
   if (gc_parser_flags & GC_PARSER_JOG_MOTION) { char_counter = 3; } // Start parsing after `$J=`
   else { char_counter = 0; }
 
+  #ifdef ENABLE_BINARY_PROTOCOL
+  if ((uint8_t)line[0] == CMD_BINARY_BLOCK) {
+    // Import the words of a binary motion block, as if parsed from the equivalent g-code line. The
+    // word mask can't repeat words and the values need no conversion, except for checks a number
+    // format would otherwise ensure.
+    uint8_t motion = line[1];
+    if (motion > GC_BINARY_MOTION_MAX) { FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); } // [Unsupported motion]
+    if (motion) {
+      axis_command = AXIS_COMMAND_MOTION_MODE;
+      gc_block.modal.motion = motion-1; // MOTION_MODE_SEEK to MOTION_MODE_CCW_ARC
+      command_words |= bit(MODAL_GROUP_G1);
+    }
+    uint8_t word_mask = line[2];
+    char_counter = 1+GC_BINARY_HEADER_SIZE;
+    uint8_t idx;
+    for (idx=0; word_mask; idx++, word_mask >>= 1) {
+      if (!(word_mask & 1)) { continue; }
+      memcpy(&value, &line[char_counter], sizeof(float));
+      char_counter += sizeof(float);
+      if (!(fabs(value) < SOME_LARGE_VALUE)) { FAIL(STATUS_BAD_NUMBER_FORMAT); } // [Not a finite value]
+      if (idx < N_AXIS) {
+        gc_block.values.xyz[idx] = value;
+        #ifdef ENABLE_FIXED_POINT_COORDINATES
+          if (!(fabs(value) <= FIXED_POINT_MAX/FIXED_POINT_SCALE)) { FAIL(STATUS_BAD_NUMBER_FORMAT); } // [Out of fixed-point range]
+          gc_block.values.xyz_fixed[idx] = lround(value*FIXED_POINT_SCALE);
+        #endif
+        axis_words |= bit(idx);
+        value_words |= (bit(WORD_X) << idx);
+      } else if (idx < 2*N_AXIS) {
+        gc_block.values.ijk[idx-N_AXIS] = value;
+        ijk_words |= (bit(0) << (idx-N_AXIS));
+        value_words |= (bit(WORD_I) << (idx-N_AXIS));
+      } else if (idx == 2*N_AXIS) {
+        gc_block.values.r = value;
+        value_words |= bit(WORD_R);
+      } else if (idx == 2*N_AXIS+1) {
+        if (value < 0.0) { FAIL(STATUS_NEGATIVE_VALUE); } // [Word value cannot be negative]
+        gc_block.values.f = value;
+        value_words |= bit(WORD_F);
+      } else { FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); } // [Unsupported word]
+    }
+  } else
+  #endif
   while (line[char_counter] != 0) { // Loop until no more g-code words in line.
 
     // Import the next g-code word, expecting a letter followed by a value. Otherwise, error out.
     letter = line[char_counter];
     if((letter < 'A') || (letter > 'Z')) { FAIL(STATUS_EXPECTED_COMMAND_LETTER); } // [Expected word letter]
     char_counter++;
+    #ifdef ENABLE_FIXED_POINT_COORDINATES
+      // Axis words are read as fixed-point only. Their value in mm follows from it.
+      uint8_t axis = letter-'X';
+      if (axis < N_WORD_AXIS) {
+        if (!read_fixed(line, &char_counter, &gc_block.values.xyz_fixed[axis])) { FAIL(STATUS_BAD_NUMBER_FORMAT); } // [Expected word value or out of fixed-point range]
+        value = gc_block.values.xyz_fixed[axis]*(1.0/FIXED_POINT_SCALE);
+      } else
+    #endif
     if (!read_float(line, &char_counter, &value)) { FAIL(STATUS_BAD_NUMBER_FORMAT); } // [Expected word value]
 
     // Convert values to smaller uint8 significand and mantissa values for parsing this word.
@@ -208,8 +411,16 @@ uint8_t gc_execute_line(char *line)
           case 61:
             word_bit = MODAL_GROUP_G13;
             if (mantissa != 0) { FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); } // [G61.1 not supported]
-            // gc_block.modal.control = CONTROL_MODE_EXACT_PATH; // G61
+            #ifdef ENABLE_PATH_BLENDING
+              gc_block.modal.control = CONTROL_MODE_EXACT_PATH; // G61
+            #endif
             break;
+          #ifdef ENABLE_PATH_BLENDING
+            case 64:
+              word_bit = MODAL_GROUP_G13;
+              gc_block.modal.control = CONTROL_MODE_BLEND; // G64
+              break;
+          #endif
           default: FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); // [Unsupported G command]
         }
         if (mantissa > 0) { FAIL(STATUS_GCODE_COMMAND_VALUE_NOT_INTEGER); } // [Unsupported or invalid Gxx.x command]
@@ -386,14 +597,28 @@ uint8_t gc_execute_line(char *line)
   // in memory and written to EEPROM only when there is not a cycle active.
   float block_coord_system[N_AXIS];
   memcpy(block_coord_system,gc_state.coord_system,sizeof(gc_state.coord_system));
+  #ifdef ENABLE_FIXED_POINT_COORDINATES
+    int32_t block_coord_fixed[N_AXIS];
+    memcpy(block_coord_fixed,gc_state.coord_fixed,sizeof(gc_state.coord_fixed));
+  #endif
   if ( bit_istrue(command_words,bit(MODAL_GROUP_G12)) ) { // Check if called in block
     if (gc_block.modal.coord_select > N_COORDINATE_SYSTEM) { FAIL(STATUS_GCODE_UNSUPPORTED_COORD_SYS); } // [Greater than N sys]
     if (gc_state.modal.coord_select != gc_block.modal.coord_select) {
       if (!(settings_read_coord_data(gc_block.modal.coord_select,block_coord_system))) { FAIL(STATUS_SETTING_READ_FAIL); }
+      #ifdef ENABLE_FIXED_POINT_COORDINATES
+        gc_convert_coord_to_fixed(block_coord_fixed, block_coord_system);
+      #endif
     }
   }
 
-  // [16. Set path control mode ]: N/A. Only G61. G61.1 and G64 NOT SUPPORTED.
+  // [16. Set path control mode ]: G64 P is the blending tolerance. Without P, the junction deviation
+  //   setting is used. G61.1 NOT SUPPORTED. Without ENABLE_PATH_BLENDING, only G61 is supported.
+  #ifdef ENABLE_PATH_BLENDING
+    if (bit_istrue(command_words,bit(MODAL_GROUP_G13)) && (gc_block.modal.control == CONTROL_MODE_BLEND)) {
+      if (bit_istrue(value_words,bit(WORD_P))) { bit_false(value_words,bit(WORD_P)); }
+      else { gc_block.values.p = settings.junction_deviation; }
+    }
+  #endif
   // [17. Set distance mode ]: N/A. Only G91.1. G90.1 NOT SUPPORTED.
   // [18. Set retract mode ]: NOT SUPPORTED.
 
@@ -451,17 +676,32 @@ uint8_t gc_execute_line(char *line)
         for (idx=0; idx<N_AXIS; idx++) { // Axes indices are consistent, so loop may be used to save flash space.
           if ( bit_isfalse(axis_words,bit(idx)) ) {
             gc_block.values.xyz[idx] = gc_state.position[idx]; // No axis word in block. Keep same axis position.
+            #ifdef ENABLE_FIXED_POINT_COORDINATES
+              gc_block.values.xyz_fixed[idx] = gc_state.position_fixed[idx];
+            #endif
           } else {
             // Update specified value according to distance mode or ignore if absolute override is active.
             // NOTE: G53 is never active with G28/30 since they are in the same modal group.
-            if (gc_block.non_modal_command != NON_MODAL_ABSOLUTE_OVERRIDE) {
-              // Apply coordinate offsets based on distance mode.
-              if (gc_block.modal.distance == DISTANCE_MODE_ABSOLUTE) {
-                gc_block.values.xyz[idx] += block_coord_system[idx] + gc_state.coord_offset[idx];
-              } else {  // Incremental mode
-                gc_block.values.xyz[idx] += gc_state.position[idx];
+            #ifdef ENABLE_FIXED_POINT_COORDINATES
+              // Offsets are applied in fixed-point only. The target in mm follows from it.
+              if (gc_block.non_modal_command != NON_MODAL_ABSOLUTE_OVERRIDE) {
+                if (gc_block.modal.distance == DISTANCE_MODE_ABSOLUTE) {
+                  gc_block.values.xyz_fixed[idx] += block_coord_fixed[idx];
+                } else {  // Incremental mode
+                  gc_block.values.xyz_fixed[idx] += gc_state.position_fixed[idx];
+                }
               }
-            }
+              gc_block.values.xyz[idx] = gc_block.values.xyz_fixed[idx]*(1.0/FIXED_POINT_SCALE);
+            #else
+              if (gc_block.non_modal_command != NON_MODAL_ABSOLUTE_OVERRIDE) {
+                // Apply coordinate offsets based on distance mode.
+                if (gc_block.modal.distance == DISTANCE_MODE_ABSOLUTE) {
+                  gc_block.values.xyz[idx] += block_coord_system[idx] + gc_state.coord_offset[idx];
+                } else {  // Incremental mode
+                  gc_block.values.xyz[idx] += gc_state.position[idx];
+                }
+              }
+            #endif
           }
         }
       }
@@ -671,7 +911,12 @@ uint8_t gc_execute_line(char *line)
     if (!(gc_block.non_modal_command == NON_MODAL_ABSOLUTE_OVERRIDE || gc_block.non_modal_command == NON_MODAL_NO_ACTION)) { FAIL(STATUS_INVALID_JOG_COMMAND); }
 
     uint8_t status = jog_execute(&plan_data, &gc_block);
-    if (status == STATUS_OK) { memcpy(gc_state.position, gc_block.values.xyz, sizeof(gc_block.values.xyz)); }
+    if (status == STATUS_OK) {
+      memcpy(gc_state.position, gc_block.values.xyz, sizeof(gc_state.position));
+      #ifdef ENABLE_FIXED_POINT_COORDINATES
+        gc_sync_position_fixed();
+      #endif
+    }
     return(status);
   }
 
@@ -702,11 +947,19 @@ uint8_t gc_execute_line(char *line)
   if (gc_state.modal.coord_select != gc_block.modal.coord_select) {
     gc_state.modal.coord_select = gc_block.modal.coord_select;
     memcpy(gc_state.coord_system,block_coord_system,N_AXIS*sizeof(float));
+    #ifdef ENABLE_FIXED_POINT_COORDINATES
+      memcpy(gc_state.coord_fixed,block_coord_fixed,sizeof(block_coord_fixed));
+    #endif
     system_flag_wco_change();
   }
 
-  // [16. Set path control mode ]: G61.1/G64 NOT SUPPORTED
-  // gc_state.modal.control = gc_block.modal.control; // NOTE: Always default.
+  // [16. Set path control mode ]: G61.1 NOT SUPPORTED
+  #ifdef ENABLE_PATH_BLENDING
+    gc_state.modal.control = gc_block.modal.control;
+    if (bit_istrue(command_words,bit(MODAL_GROUP_G13)) && (gc_state.modal.control == CONTROL_MODE_BLEND)) {
+      gc_state.blend_tolerance = gc_block.values.p;
+    }
+  #endif
 
   // [17. Set distance mode ]:
   gc_state.modal.distance = gc_block.modal.distance;
@@ -720,6 +973,9 @@ uint8_t gc_execute_line(char *line)
       // Update system coordinate system if currently active.
       if (gc_state.modal.coord_select == coord_select) {
         memcpy(gc_state.coord_system,gc_block.values.ijk,N_AXIS*sizeof(float));
+        #ifdef ENABLE_FIXED_POINT_COORDINATES
+          gc_convert_coord_to_fixed(gc_state.coord_fixed, gc_state.coord_system);
+        #endif
         system_flag_wco_change();
       }
       break;
@@ -733,21 +989,43 @@ uint8_t gc_execute_line(char *line)
   if (gc_state.modal.motion != MOTION_MODE_NONE) {
     if (axis_command == AXIS_COMMAND_MOTION_MODE) {
       uint8_t gc_update_pos = GC_UPDATE_POS_TARGET;
+      #ifdef ENABLE_INCREMENTAL_ARCS
+        mc_finish_arc(); // Queue any remaining arc segments first.
+      #endif
       if (gc_state.modal.motion == MOTION_MODE_LINEAR) {
+        #ifdef ENABLE_PATH_BLENDING
+          if (gc_state.modal.control == CONTROL_MODE_BLEND) { pl_data->blend_tolerance = gc_state.blend_tolerance; }
+        #endif
+        #ifdef ENABLE_FIXED_POINT_COORDINATES
+          gc_set_step_target(gc_block.values.xyz, gc_block.values.xyz_fixed, pl_data);
+        #endif
         mc_line(gc_block.values.xyz, pl_data);
       } else if (gc_state.modal.motion == MOTION_MODE_SEEK) {
         pl_data->condition |= PL_COND_FLAG_RAPID_MOTION; // Set rapid motion condition flag.
+        #ifdef ENABLE_FIXED_POINT_COORDINATES
+          gc_set_step_target(gc_block.values.xyz, gc_block.values.xyz_fixed, pl_data);
+        #endif
         mc_line(gc_block.values.xyz, pl_data);
       } else if ((gc_state.modal.motion == MOTION_MODE_CW_ARC) || (gc_state.modal.motion == MOTION_MODE_CCW_ARC)) {
-        mc_arc(gc_block.values.xyz, pl_data, gc_state.position, gc_block.values.ijk, gc_block.values.r,
-            axis_0, axis_1, axis_linear, bit_istrue(gc_parser_flags,GC_PARSER_ARC_IS_CLOCKWISE));
+        #ifdef ENABLE_INCREMENTAL_ARCS
+          mc_start_arc(gc_block.values.xyz, pl_data, gc_state.position, gc_block.values.ijk, gc_block.values.r,
+              axis_0, axis_1, axis_linear, bit_istrue(gc_parser_flags,GC_PARSER_ARC_IS_CLOCKWISE));
+        #else
+          mc_arc(gc_block.values.xyz, pl_data, gc_state.position, gc_block.values.ijk, gc_block.values.r,
+              axis_0, axis_1, axis_linear, bit_istrue(gc_parser_flags,GC_PARSER_ARC_IS_CLOCKWISE));
+        #endif
       }
 
       // As far as the parser is concerned, the position is now == target. In reality the
       // motion control system might still be processing the action and the real tool position
       // in any intermediate location.
       if (gc_update_pos == GC_UPDATE_POS_TARGET) {
-        memcpy(gc_state.position, gc_block.values.xyz, sizeof(gc_block.values.xyz)); // gc_state.position[] = gc_block.values.xyz[]
+        memcpy(gc_state.position, gc_block.values.xyz, sizeof(gc_state.position)); // gc_state.position[] = gc_block.values.xyz[]
+        #ifdef ENABLE_FIXED_POINT_COORDINATES
+          if (pl_data->condition & PL_COND_FLAG_STEP_TARGET) {
+            memcpy(gc_state.position_fixed, gc_block.values.xyz_fixed, sizeof(gc_state.position_fixed));
+          } else { gc_sync_position_fixed(); } // Arc motions
+        #endif
       } else if (gc_update_pos == GC_UPDATE_POS_SYSTEM) {
         gc_sync_position(); // gc_state.position[] = sys_position
       } // == GC_UPDATE_POS_NONE
@@ -784,6 +1062,9 @@ uint8_t gc_execute_line(char *line)
       // Execute coordinate change.
       if (sys.state != STATE_CHECK_MODE) {
         if (!(settings_read_coord_data(gc_state.modal.coord_select,gc_state.coord_system))) { FAIL(STATUS_SETTING_READ_FAIL); }
+        #ifdef ENABLE_FIXED_POINT_COORDINATES
+          gc_convert_coord_to_fixed(gc_state.coord_fixed, gc_state.coord_system);
+        #endif
         system_flag_wco_change(); // Set to refresh immediately just in case something altered.
       }
       report_feedback_message(MESSAGE_PROGRAM_END);
@@ -38,7 +38,7 @@
 #define MODAL_GROUP_G6 6 // [G20,G21] Units
 #define MODAL_GROUP_G7 7 // [G40] Cutter radius compensation mode. G41/42 NOT SUPPORTED.
 #define MODAL_GROUP_G12 9 // [G54,G55,G56,G57,G58,G59] Coordinate system selection
-#define MODAL_GROUP_G13 10 // [G61] Control mode
+#define MODAL_GROUP_G13 10 // [G61,G64] Control mode
 
 #define MODAL_GROUP_M4 11  // [M0,M1,M2,M30] Stopping
 #define MODAL_GROUP_M9 14 // [M56] Override control
@@ -89,6 +89,7 @@
 
 // Modal Group G13: Control mode
 #define CONTROL_MODE_EXACT_PATH 0 // G61 (Default: Must be zero)
+#define CONTROL_MODE_BLEND 1 // G64. Requires ENABLE_PATH_BLENDING.
 
 // Modal Group G12: Active work coordinate system
 // N/A: Stores coordinate system value (54-59) to change to.
@@ -107,6 +108,13 @@
 #define WORD_Y  11
 #define WORD_Z  12
 
+// Number of axes with g-code axis words. The A, B and C axes have none.
+#if N_AXIS > 3
+  #define N_WORD_AXIS 3
+#else
+  #define N_WORD_AXIS N_AXIS
+#endif
+
 // Define g-code parser position updating flags
 #define GC_UPDATE_POS_TARGET   0 // Must be zero
 #define GC_UPDATE_POS_SYSTEM   1
@@ -128,17 +136,23 @@ typedef struct {
   uint8_t coord_select;    // {G54,G55,G56,G57,G58,G59}
   uint8_t program_flow;    // {M0,M1,M2,M30}
   uint8_t override;        // {M56}
+  #ifdef ENABLE_PATH_BLENDING
+    uint8_t control;       // {G61,G64}
+  #endif
 } gc_modal_t;
 
 typedef struct {
   float f;         // Feed
-  float ijk[3];    // I,J,K Axis arc offsets
+  float ijk[N_AXIS]; // I,J,K Axis arc offsets. Also G10 coordinate data of all axes.
   uint8_t l;       // G10 or canned cycles parameters
   int32_t n;       // Line number
   float p;         // G10 or dwell parameters
   // float q;      // G82 peck drilling
   float r;         // Arc radius
-  float xyz[3];    // X,Y,Z Translational axes
+  float xyz[N_AXIS]; // X,Y,Z Translational axes. Axes without g-code words keep their position.
+  #ifdef ENABLE_FIXED_POINT_COORDINATES
+    int32_t xyz_fixed[N_AXIS]; // Axes in fixed-point units
+  #endif
 } gc_values_t;
 
 
@@ -149,11 +163,18 @@ typedef struct {
   int32_t line_number;          // Last line number sent
 
   float position[N_AXIS];       // Where the interpreter considers the tool to be at this point in the code
+  #ifdef ENABLE_PATH_BLENDING
+    float blend_tolerance;      // G64 P corner blending tolerance (mm)
+  #endif
 
   float coord_system[N_AXIS];    // Current work coordinate system (G54+). Stores offset from absolute machine
                                  // position in mm. Loaded from EEPROM when called.
   float coord_offset[N_AXIS];    // Retains the G92 coordinate offset (work coordinates) relative to
                                  // machine zero in mm. Non-persistent. Cleared upon reset and boot.
+  #ifdef ENABLE_FIXED_POINT_COORDINATES
+    int32_t position_fixed[N_AXIS]; // Parser position in fixed-point units. Exact after G0/G1 motions.
+    int32_t coord_fixed[N_AXIS];    // Sum of the coordinate system and offset in fixed-point units.
+  #endif
 } parser_state_t;
 extern parser_state_t gc_state;
 
@@ -165,13 +186,29 @@ typedef struct {
 } parser_block_t;
 
 
+#ifdef ENABLE_BINARY_PROTOCOL
+  // Binary motion block format following CMD_BINARY_BLOCK. See config.h.
+  #define GC_BINARY_HEADER_SIZE 2                  // Motion and word mask bytes
+  #define GC_BINARY_MOTION_MAX 4                   // Motion values 1-4 are G0-G3. Zero keeps the modal motion.
+  #define GC_BINARY_WORD_AXIS(idx) bit(idx)        // X,Y,Z axis words
+  #define GC_BINARY_WORD_IJK(idx) bit(N_AXIS+idx)  // I,J,K arc offset words
+  #define GC_BINARY_WORD_R bit(2*N_AXIS)
+  #define GC_BINARY_WORD_F bit(2*N_AXIS+1)
+  #define GC_BINARY_BLOCK_SIZE (1+GC_BINARY_HEADER_SIZE+4*8) // Maximum block size. A word per mask bit.
+#endif
+
 // Initialize the parser
 void gc_init();
 
-// Execute one block of rs275/ngc/g-code
+// Execute one block of rs275/ngc/g-code. A binary motion block starts with CMD_BINARY_BLOCK.
 uint8_t gc_execute_line(char *line);
 
 // Set g-code parser position. Input in steps.
 void gc_sync_position();
 
+#ifdef ENABLE_FIXED_POINT_COORDINATES
+  // Set g-code parser fixed-point position from the parser position in mm.
+  void gc_sync_position_fixed();
+#endif
+
 #endif
@@ -71,6 +71,13 @@
   #error "Override refresh must be greater than zero."
 #endif
 
+#if (N_AXIS < 2) || (N_AXIS > 6)
+  #error "N_AXIS must be between 2 and 6."
+#endif
+#if defined(ENABLE_BINARY_PROTOCOL) && (N_AXIS > 3)
+  #error "ENABLE_BINARY_PROTOCOL supports up to 3 axes."
+#endif
+
 #if defined(ENABLE_DUAL_AXIS)
   #if !((DUAL_AXIS_SELECT == X_AXIS) || (DUAL_AXIS_SELECT == Y_AXIS))
     #error "Dual axis currently supports X or Y axes only."
@@ -86,6 +93,21 @@
   #endif
 #endif
 
+#if defined(ENABLE_INCREMENTAL_ARCS) && defined(ENABLE_NATIVE_ARC_BLOCKS)
+  #error "ENABLE_INCREMENTAL_ARCS not supported with native arc blocks."
+#endif
+#if defined(ENABLE_ADAPTIVE_ARC_SEGMENTS) && defined(ENABLE_NATIVE_ARC_BLOCKS)
+  #error "ENABLE_ADAPTIVE_ARC_SEGMENTS not supported with native arc blocks."
+#endif
+#if defined(ENABLE_STEP_BURST) && (defined(STEP_PULSE_DELAY) || defined(ENABLE_DUAL_AXIS))
+  #error "ENABLE_STEP_BURST not supported with STEP_PULSE_DELAY or dual axis."
+#endif
+#if defined(JUNCTION_FACTOR_TABLE_SIZE)
+  #if (JUNCTION_FACTOR_TABLE_SIZE < 4) || (JUNCTION_FACTOR_TABLE_SIZE > 128)
+    #error "JUNCTION_FACTOR_TABLE_SIZE must be between 4 and 128."
+  #endif
+#endif
+
 // ---------------------------------------------------------------------------------------
 
 #endif
@@ -32,6 +32,9 @@ uint8_t jog_execute(plan_line_data_t *pl_data, parser_block_t *gc_block)
   #endif
 
   // Valid jog command. Plan, set state, and execute.
+  #ifdef ENABLE_INCREMENTAL_ARCS
+    mc_finish_arc(); // Queue any remaining arc segments first.
+  #endif
   mc_line(gc_block->values.xyz,pl_data);
   if (sys.state == STATE_IDLE) {
     if (plan_get_current_block() != NULL) { // Check if there is a block to execute.
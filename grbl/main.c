@@ -28,9 +28,16 @@ int32_t sys_position[N_AXIS];      // Real-time machine position vector in steps
 volatile uint8_t sys_rt_exec_state;   // Global realtime executor bitflag variable for state management. See EXEC bitmasks.
 volatile uint8_t sys_rt_exec_alarm;   // Global realtime executor bitflag variable for setting various alarms.
 volatile uint8_t sys_rt_exec_motion_override; // Global realtime executor bitflag variable for motion-based overrides.
+#ifdef ENABLE_CONTINUOUS_OVERRIDES
+  volatile uint8_t sys_rt_f_override_value; // Feed override value of a continuous override command. Zero, if none.
+  volatile uint8_t sys_rt_r_override_value; // Rapid override value of a continuous override command. Zero, if none.
+#endif
 #ifdef DEBUG
   volatile uint8_t sys_rt_exec_debug;
 #endif
+#ifdef ENABLE_MAIN_LOOP_TELEMETRY
+  sys_telemetry_t sys_telemetry;
+#endif
 
 
 int main(void)
@@ -39,6 +46,9 @@ int main(void)
   serial_init();   // Setup serial baud rate and interrupts
   settings_init(); // Load Grbl settings from EEPROM
   stepper_init();  // Configure stepper pins and interrupt timers
+  #ifdef ENABLE_MAIN_LOOP_TELEMETRY
+    system_init_telemetry(); // Start telemetry timer
+  #endif
 
   memset(sys_position,0,sizeof(sys_position)); // Clear machine position.
   sei(); // Enable interrupts
@@ -56,11 +66,21 @@ int main(void)
     sys_rt_exec_state = 0;
     sys_rt_exec_alarm = 0;
     sys_rt_exec_motion_override = 0;
+    #ifdef ENABLE_CONTINUOUS_OVERRIDES
+      sys_rt_f_override_value = 0;
+      sys_rt_r_override_value = 0;
+    #endif
 
     // Reset Grbl primary systems.
     serial_reset_read_buffer(); // Clear serial read buffer
     gc_init(); // Set g-code parser to default state
     plan_reset(); // Clear block buffer and planner variables
+    #ifdef ENABLE_PARSE_AHEAD_QUEUE
+      mc_reset_queue(); // Clear line motions queued ahead of the planner
+    #endif
+    #ifdef ENABLE_INCREMENTAL_ARCS
+      mc_reset_arc(); // Clear the remaining segments of an arc
+    #endif
     st_reset(); // Clear stepper subsystem variables.
 
     // Sync cleared gcode and planner positions to current system position.
@@ -22,6 +22,139 @@
 #include "grbl.h"
 
 
+#ifdef ENABLE_PATH_BLENDING
+  // Rounds the corner between the last queued line motion and the new line motion to target with a
+  // tangent arc, such that the path deviates at most the G64 P tolerance from the corner. The last
+  // queued line is replaced by a line ending at the arc start, then the arc is queued. The new line
+  // motion is queued from the arc end by mc_line(). Only corners within the XY plane are blended, and
+  // the arc takes at most half of either line, leaving the other half for the neighboring corner.
+  static void mc_blend_corner(float *target, plan_line_data_t *pl_data)
+  {
+    float start[N_AXIS], corner[N_AXIS];
+    plan_line_data_t blend_data;
+    memcpy(&blend_data, pl_data, sizeof(plan_line_data_t));
+    blend_data.blend_tolerance = 0.0;
+    #ifdef ENABLE_FIXED_POINT_COORDINATES
+      blend_data.condition &= ~PL_COND_FLAG_STEP_TARGET; // The blend motions end off the step target.
+    #endif
+    if (!plan_get_last_line_start(start, &blend_data)) { return; }
+    plan_get_planner_mpos(corner);
+    uint8_t idx;
+    for (idx=0; idx<N_AXIS; idx++) {
+      if ((idx != X_AXIS) && (idx != Y_AXIS) && ((start[idx] != corner[idx]) || (target[idx] != corner[idx]))) { return; }
+    }
+
+    float unit_vec_0[2], unit_vec_1[2];
+    unit_vec_0[X_AXIS] = corner[X_AXIS]-start[X_AXIS];
+    unit_vec_0[Y_AXIS] = corner[Y_AXIS]-start[Y_AXIS];
+    unit_vec_1[X_AXIS] = target[X_AXIS]-corner[X_AXIS];
+    unit_vec_1[Y_AXIS] = target[Y_AXIS]-corner[Y_AXIS];
+    float length_0 = hypot_f(unit_vec_0[X_AXIS], unit_vec_0[Y_AXIS]);
+    float length_1 = hypot_f(unit_vec_1[X_AXIS], unit_vec_1[Y_AXIS]);
+    if ((length_0 == 0.0) || (length_1 == 0.0)) { return; }
+    for (idx=0; idx<2; idx++) {
+      unit_vec_0[idx] /= length_0;
+      unit_vec_1[idx] /= length_1;
+    }
+
+    // Corners with a negligible direction change need no blending. The arc tangent points lie at
+    // distance d = R*tan(theta/2) from the corner, where the arc deviates R*(1/cos(theta/2)-1) from it.
+    float cos_theta = unit_vec_0[X_AXIS]*unit_vec_1[X_AXIS] + unit_vec_0[Y_AXIS]*unit_vec_1[Y_AXIS];
+    if (cos_theta > 0.999999) { return; }
+    float cos_theta_d2 = sqrt(0.5*(1.0+cos_theta)); // Trig half angle identities.
+    float sin_theta_d2 = sqrt(0.5*(1.0-cos_theta));
+    float distance = pl_data->blend_tolerance*sin_theta_d2/(1.0-cos_theta_d2);
+    distance = min(distance, 0.5*min(length_0, length_1));
+    float radius = distance*cos_theta_d2/sin_theta_d2;
+    if (radius <= settings.arc_tolerance) { return; } // Nearly reversing corner. Too small to blend.
+
+    // Replace the last line with one ending at the arc start. Queued directly into the freed block,
+    // such that the stepper segment generator never finds the block missing.
+    float arc_start[N_AXIS], arc_end[N_AXIS], offset[N_AXIS];
+    memcpy(arc_start, corner, sizeof(corner));
+    memcpy(arc_end, corner, sizeof(corner));
+    for (idx=0; idx<2; idx++) {
+      arc_start[idx] -= distance*unit_vec_0[idx];
+      arc_end[idx] += distance*unit_vec_1[idx];
+    }
+    plan_remove_last_block();
+    plan_buffer_line(arc_start, &blend_data); // Keeps the line number of the replaced line.
+    #ifdef USE_LINE_NUMBERS
+      blend_data.line_number = pl_data->line_number; // The arc leads into the new line.
+    #endif
+
+    // The arc center lies on the normal of the last line towards the turn.
+    uint8_t is_clockwise_arc = ((unit_vec_0[X_AXIS]*unit_vec_1[Y_AXIS] - unit_vec_0[Y_AXIS]*unit_vec_1[X_AXIS]) < 0.0);
+    if (is_clockwise_arc) {
+      offset[X_AXIS] = radius*unit_vec_0[Y_AXIS];
+      offset[Y_AXIS] = -radius*unit_vec_0[X_AXIS];
+    } else {
+      offset[X_AXIS] = -radius*unit_vec_0[Y_AXIS];
+      offset[Y_AXIS] = radius*unit_vec_0[X_AXIS];
+    }
+    mc_arc(arc_end, &blend_data, arc_start, offset, radius, X_AXIS, Y_AXIS, N_AXIS, is_clockwise_arc);
+  }
+#endif
+
+
+#ifdef ENABLE_PARSE_AHEAD_QUEUE
+  // Line motions queued ahead of the planner buffer, as passed to mc_line().
+  typedef struct {
+    float target[N_AXIS];
+    plan_line_data_t pl_data;
+  } mc_queue_t;
+  static mc_queue_t mc_queue[PARSE_AHEAD_QUEUE_SIZE];
+  static uint8_t mc_queue_tail;
+  static uint8_t mc_queue_count;
+  static uint8_t mc_queue_busy; // Set while a line motion is planned. Its nested motions are not queued.
+
+
+  // Queues a line motion behind any queued motions. If the queue is full, remains in this loop until
+  // the planner takes a queued motion.
+  static void mc_queue_line(float *target, plan_line_data_t *pl_data)
+  {
+    while (mc_queue_count == PARSE_AHEAD_QUEUE_SIZE) {
+      protocol_execute_realtime(); // Check for any run-time commands
+      if (sys.abort) { return; } // Bail, if system abort.
+      mc_execute_queue();
+      if (mc_queue_count == PARSE_AHEAD_QUEUE_SIZE) { protocol_auto_cycle_start(); } // Auto-cycle start when buffers are full.
+    }
+    uint8_t index = mc_queue_tail+mc_queue_count;
+    if (index >= PARSE_AHEAD_QUEUE_SIZE) { index -= PARSE_AHEAD_QUEUE_SIZE; }
+    memcpy(mc_queue[index].target, target, sizeof(mc_queue[index].target));
+    memcpy(&mc_queue[index].pl_data, pl_data, sizeof(plan_line_data_t));
+    mc_queue_count++;
+    mc_execute_queue(); // In case the planner freed a block in the meantime.
+    if (mc_queue_count) { protocol_auto_cycle_start(); }
+  }
+
+
+  void mc_execute_queue()
+  {
+    if (mc_queue_busy) { return; }
+    while (mc_queue_count && !plan_check_full_buffer()) {
+      mc_queue_busy = true;
+      mc_line(mc_queue[mc_queue_tail].target, &mc_queue[mc_queue_tail].pl_data);
+      mc_queue_busy = false;
+      if (sys.abort) { return; } // The queue is reset with the system.
+      if (++mc_queue_tail == PARSE_AHEAD_QUEUE_SIZE) { mc_queue_tail = 0; }
+      mc_queue_count--;
+    }
+  }
+
+
+  uint8_t mc_check_queue() { return(mc_queue_count != 0); }
+
+
+  void mc_reset_queue()
+  {
+    mc_queue_tail = 0;
+    mc_queue_count = 0;
+    mc_queue_busy = false;
+  }
+#endif
+
+
 // Execute linear motion in absolute millimeter coordinates. Feed rate given in millimeters/second
 // unless invert_feed_rate is true. Then the feed_rate means that the motion should be completed in
 // (1 minute)/feed_rate time.
@@ -34,6 +167,57 @@ void mc_line(float *target, plan_line_data_t *pl_data)
   // If in check gcode mode, prevent motion by blocking planner.
   if (sys.state == STATE_CHECK_MODE) { return; }
 
+  #ifdef ENABLE_PARSE_AHEAD_QUEUE
+    // Queue the motion, if the planner buffer is full or motions are queued already. Otherwise, plan it
+    // right away, along with any nested motions, like the parts of a split line or a blend arc.
+    if (!mc_queue_busy) {
+      if (mc_queue_count || plan_check_full_buffer()) { mc_queue_line(target, pl_data); }
+      else {
+        mc_queue_busy = true;
+        mc_line(target, pl_data);
+        mc_queue_busy = false;
+      }
+      return;
+    }
+  #endif
+
+  #ifdef PLAN_MAX_BLOCK_STEPS
+    // Compact planner blocks and fixed-point segment prep handle up to PLAN_MAX_BLOCK_STEPS steps per
+    // axis. Split longer lines into equal collinear parts, which the planner joins without slowing down.
+    // Native arc blocks are split by mc_arc() instead.
+    if (!(pl_data->condition & PL_COND_FLAG_ARC_MOTION)) {
+      float position[N_AXIS];
+      float max_steps = 0.0;
+      uint8_t idx;
+      plan_get_planner_mpos(position);
+      for (idx=0; idx<N_AXIS; idx++) {
+        max_steps = max(max_steps, fabs(target[idx]-position[idx])*settings.steps_per_mm[idx]);
+      }
+      if (max_steps > (PLAN_MAX_BLOCK_STEPS-1)) {
+        // Each part rounds to at most one step more than its exact travel.
+        uint16_t parts = max_steps/(PLAN_MAX_BLOCK_STEPS-1) + 1;
+        if (pl_data->condition & PL_COND_FLAG_INVERSE_TIME) { pl_data->feed_rate *= parts; }
+        float part_target[N_AXIS];
+        uint16_t part;
+        #ifdef ENABLE_FIXED_POINT_COORDINATES
+          // Only the last part ends at the step target. The others are planned from their targets in mm.
+          uint8_t condition = pl_data->condition;
+          pl_data->condition &= ~PL_COND_FLAG_STEP_TARGET;
+        #endif
+        for (part=1; part<parts; part++) {
+          for (idx=0; idx<N_AXIS; idx++) {
+            part_target[idx] = position[idx] + (target[idx]-position[idx])*part/parts;
+          }
+          mc_line(part_target, pl_data);
+          if (sys.abort) { return; }
+        }
+        #ifdef ENABLE_FIXED_POINT_COORDINATES
+          pl_data->condition = condition;
+        #endif
+      }
+    }
+  #endif
+
   // NOTE: Backlash compensation may be installed here. It will need direction info to track when
   // to insert a backlash line motion(s) before the intended line motion and will require its own
   // plan_check_full_buffer() and check for system abort loop. Also for position reporting
@@ -48,6 +232,14 @@ void mc_line(float *target, plan_line_data_t *pl_data)
   // doesn't update the machine position values. Since the position values used by the g-code
   // parser and planner are separate from the system machine positions, this is doable.
 
+  #ifdef ENABLE_PATH_BLENDING
+    // Blend the corner with the last queued line before it may be loaded by the stepper.
+    if (pl_data->blend_tolerance > 0.0) {
+      mc_blend_corner(target, pl_data);
+      if (sys.abort) { return; }
+    }
+  #endif
+
   // If the buffer is full: good! That means we are well ahead of the robot.
   // Remain in this loop until there is room in the buffer.
   do {
@@ -63,15 +255,56 @@ void mc_line(float *target, plan_line_data_t *pl_data)
 }
 
 
-// Execute an arc in offset mode format. position == current xyz, target == target xyz,
-// offset == offset from current xyz, axis_X defines circle plane in tool space, axis_linear is
-// the direction of helical travel, radius == circle radius, isclockwise boolean. Used
-// for vector transformation direction.
-// The arc is approximated by generating a huge number of tiny, linear segments. The chordal tolerance
-// of each segment is configured in settings.arc_tolerance, which is defined to be the maximum normal
-// distance from segment to the circle when the end points both lie on the circle.
-void mc_arc(float *target, plan_line_data_t *pl_data, float *position, float *offset, float radius,
-  uint8_t axis_0, uint8_t axis_1, uint8_t axis_linear, uint8_t is_clockwise_arc)
+#ifdef ENABLE_PREPLANNED_BLOCKS
+  // Execute a host-planned block. The block data is checked, such that no frame data can break the
+  // planner, since it bypasses the g-code parser.
+  uint8_t mc_host_block(plan_host_block_t *host_block)
+  {
+    // NOTE: Written such that NaN values fail the checks.
+    if (!(host_block->millimeters > 0.0) || !(host_block->acceleration > 0.0) ||
+        !(host_block->programmed_rate > 0.0) || !(host_block->rapid_rate > 0.0) ||
+        !(host_block->rapid_rate < PLAN_MAX_HOST_RATE) || !(host_block->max_entry_speed_sqr >= 0.0) ||
+        !(host_block->entry_speed_sqr >= 0.0) || !(host_block->exit_speed_sqr >= 0.0)) {
+      return(STATUS_PLANNED_BLOCK_INVALID);
+    }
+    #ifdef PLAN_MAX_BLOCK_STEPS
+      uint8_t idx;
+      for (idx=0; idx<N_AXIS; idx++) {
+        if (labs(host_block->steps[idx]) > PLAN_MAX_BLOCK_STEPS) { return(STATUS_PLANNED_BLOCK_INVALID); }
+      }
+    #endif
+
+    // If in check gcode mode, prevent motion by blocking planner.
+    if (sys.state == STATE_CHECK_MODE) { return(STATUS_OK); }
+
+    #ifdef ENABLE_INCREMENTAL_ARCS
+      mc_finish_arc(); // Queue any remaining arc segments first.
+    #endif
+
+    // Remain in this loop until there is room in the buffer, as in mc_line().
+    do {
+      protocol_execute_realtime(); // Check for any run-time commands
+      if (sys.abort) { return(STATUS_OK); } // Bail, if system abort.
+      #ifdef ENABLE_PARSE_AHEAD_QUEUE
+        mc_execute_queue(); // Queued line motions are planned first.
+        if ( plan_check_full_buffer() || mc_queue_count ) { protocol_auto_cycle_start(); }
+        else { break; }
+      #else
+        if ( plan_check_full_buffer() ) { protocol_auto_cycle_start(); } // Auto-cycle start when buffer is full.
+        else { break; }
+      #endif
+    } while (1);
+
+    plan_buffer_host_block(host_block);
+    return(STATUS_OK);
+  }
+#endif
+
+
+// Computes the signed angular travel of an arc from position to target around the center at offset.
+// Counter-clockwise is positive.
+static float mc_compute_arc_angular_travel(float *target, float *position, float *offset, uint8_t axis_0,
+  uint8_t axis_1, uint8_t is_clockwise_arc)
 {
   float center_axis0 = position[axis_0] + offset[axis_0];
   float center_axis1 = position[axis_1] + offset[axis_1];
@@ -87,96 +320,284 @@ void mc_arc(float *target, plan_line_data_t *pl_data, float *position, float *of
   } else {
     if (angular_travel <= ARC_ANGULAR_TRAVEL_EPSILON) { angular_travel += 2*M_PI; }
   }
+  return(angular_travel);
+}
+
+
+#ifndef ENABLE_NATIVE_ARC_BLOCKS
+  // Arc line segment generator. Holds everything needed to compute and queue the remaining segments.
+  typedef struct {
+    float position[N_AXIS];     // Target of the last queued segment
+    float target[N_AXIS];       // Arc target. The last segment ends here.
+    plan_line_data_t pl_data;
+    float center_axis0;
+    float center_axis1;
+    float r_axis0;              // Radius vector from center to current location
+    float r_axis1;
+    float offset_axis0;         // Center offset from the arc start position
+    float offset_axis1;
+    float theta_per_segment;
+    float linear_per_segment;
+    float cos_T;
+    float sin_T;
+    uint16_t segments;          // Number of segments, including the last one to target.
+    uint16_t segment;           // Index of the next segment, from 1 to segments.
+    uint8_t count;              // Segments since the last arc correction
+    uint8_t axis_0;
+    uint8_t axis_1;
+    uint8_t axis_linear;
+  } mc_arc_t;
+
+  #ifdef ENABLE_INCREMENTAL_ARCS
+    static mc_arc_t mc_pending_arc;
+    static uint8_t mc_arc_pending; // Set while the pending arc has segments left to queue.
+  #endif
+
+
+  // Returns true if a line motion would have to wait for room in the planner buffer.
+  static uint8_t mc_check_full_buffer()
+  {
+    #ifdef ENABLE_PARSE_AHEAD_QUEUE
+      if (mc_queue_count) { return(true); } // Queued line motions are planned first.
+    #endif
+    return(plan_check_full_buffer());
+  }
+
+
+  // Initializes the arc line segment generator. See mc_arc() for the arguments.
+  static void mc_init_arc(mc_arc_t *arc, float *target, plan_line_data_t *pl_data, float *position,
+    float *offset, float radius, uint8_t axis_0, uint8_t axis_1, uint8_t axis_linear, uint8_t is_clockwise_arc)
+  {
+    float angular_travel = mc_compute_arc_angular_travel(target, position, offset, axis_0, axis_1, is_clockwise_arc);
+    memcpy(arc->position, position, sizeof(arc->position));
+    memcpy(arc->target, target, sizeof(arc->target));
+    memcpy(&arc->pl_data, pl_data, sizeof(plan_line_data_t));
+    arc->center_axis0 = position[axis_0] + offset[axis_0];
+    arc->center_axis1 = position[axis_1] + offset[axis_1];
+    arc->r_axis0 = -offset[axis_0];
+    arc->r_axis1 = -offset[axis_1];
+    arc->offset_axis0 = offset[axis_0];
+    arc->offset_axis1 = offset[axis_1];
+    arc->axis_0 = axis_0;
+    arc->axis_1 = axis_1;
+    arc->axis_linear = axis_linear;
+    arc->segment = 1;
+    arc->count = 0;
+
+    // NOTE: Segment end points are on the arc, which can lead to the arc diameter being smaller by up to
+    // (2x) settings.arc_tolerance. For 99% of users, this is just fine. If a different arc segment fit
+    // is desired, i.e. least-squares, midpoint on arc, just change the mm_per_arc_segment calculation.
+    // For the intended uses of Grbl, this value shouldn't exceed 2000 for the strictest of cases.
+    uint16_t segments = floor(fabs(0.5*angular_travel*radius)/
+                            sqrt(settings.arc_tolerance*(2*radius - settings.arc_tolerance)) );
+
+    if (segments) {
+      // Multiply inverse feed_rate to compensate for the fact that this movement is approximated
+      // by a number of discrete segments. The inverse feed_rate should be correct for the sum of
+      // all segments.
+      if (arc->pl_data.condition & PL_COND_FLAG_INVERSE_TIME) {
+        arc->pl_data.feed_rate *= segments;
+        bit_false(arc->pl_data.condition,PL_COND_FLAG_INVERSE_TIME); // Force as feed absolute mode over arc segments.
+      }
+
+      arc->theta_per_segment = angular_travel/segments;
+      arc->linear_per_segment = 0.0;
+      if (axis_linear < N_AXIS) { arc->linear_per_segment = (target[axis_linear] - position[axis_linear])/segments; }
+
+      #ifdef ENABLE_ADAPTIVE_ARC_SEGMENTS
+        // Limit the feed rate, such that a segment takes at least ARC_MIN_SEGMENT_TIME to execute. Unless
+        // the planner junction speed between segments is lower already. For a junction deflection of
+        // theta_per_segment, 1-sin(theta/2) is about theta_per_segment^2/8 in the planner junction speed.
+        float segment_rate = hypot_f(arc->theta_per_segment*radius, arc->linear_per_segment)*(60000.0/ARC_MIN_SEGMENT_TIME);
+        float junction_rate = sqrt(8.0*min(settings.acceleration[axis_0],settings.acceleration[axis_1])*
+                                   settings.junction_deviation)/fabs(arc->theta_per_segment);
+        if (segment_rate < min(arc->pl_data.feed_rate, junction_rate)) { arc->pl_data.feed_rate = segment_rate; }
+      #endif
+
+      /* Vector rotation by transformation matrix: r is the original vector, r_T is the rotated vector,
+         and phi is the angle of rotation. Solution approach by Jens Geisler.
+             r_T = [cos(phi) -sin(phi);
+                    sin(phi)  cos(phi] * r ;
 
-  // NOTE: Segment end points are on the arc, which can lead to the arc diameter being smaller by up to
-  // (2x) settings.arc_tolerance. For 99% of users, this is just fine. If a different arc segment fit
-  // is desired, i.e. least-squares, midpoint on arc, just change the mm_per_arc_segment calculation.
-  // For the intended uses of Grbl, this value shouldn't exceed 2000 for the strictest of cases.
-  uint16_t segments = floor(fabs(0.5*angular_travel*radius)/
-                          sqrt(settings.arc_tolerance*(2*radius - settings.arc_tolerance)) );
-
-  if (segments) {
-    // Multiply inverse feed_rate to compensate for the fact that this movement is approximated
-    // by a number of discrete segments. The inverse feed_rate should be correct for the sum of
-    // all segments.
-    if (pl_data->condition & PL_COND_FLAG_INVERSE_TIME) {
-      pl_data->feed_rate *= segments;
-      bit_false(pl_data->condition,PL_COND_FLAG_INVERSE_TIME); // Force as feed absolute mode over arc segments.
+         For arc generation, the center of the circle is the axis of rotation and the radius vector is
+         defined from the circle center to the initial position. Each line segment is formed by successive
+         vector rotations. Single precision values can accumulate error greater than tool precision in rare
+         cases. So, exact arc path correction is implemented. This approach avoids the problem of too many very
+         expensive trig operations [sin(),cos(),tan()] which can take 100-200 usec each to compute.
+
+         Small angle approximation may be used to reduce computation overhead further. A third-order approximation
+         (second order sin() has too much error) holds for most, if not, all CNC applications. Note that this
+         approximation will begin to accumulate a numerical drift error when theta_per_segment is greater than
+         ~0.25 rad(14 deg) AND the approximation is successively used without correction several dozen times. This
+         scenario is extremely unlikely, since segment lengths and theta_per_segment are automatically generated
+         and scaled by the arc tolerance setting. Only a very large arc tolerance setting, unrealistic for CNC
+         applications, would cause this numerical drift error. However, it is best to set N_ARC_CORRECTION from a
+         low of ~4 to a high of ~20 or so to avoid trig operations while keeping arc generation accurate.
+
+         This approximation also allows mc_arc to immediately insert a line segment into the planner
+         without the initial overhead of computing cos() or sin(). By the time the arc needs to be applied
+         a correction, the planner should have caught up to the lag caused by the initial mc_arc overhead.
+         This is important when there are successive arc motions.
+      */
+      // Computes: cos_T = 1 - theta_per_segment^2/2, sin_T = theta_per_segment - theta_per_segment^3/6) in ~52usec
+      arc->cos_T = 2.0 - arc->theta_per_segment*arc->theta_per_segment;
+      arc->sin_T = arc->theta_per_segment*0.16666667*(arc->cos_T + 4.0);
+      arc->cos_T *= 0.5;
+    } else {
+      segments = 1; // Only the last segment to target.
     }
+    arc->segments = segments;
+  }
 
-    float theta_per_segment = angular_travel/segments;
-    float linear_per_segment = (target[axis_linear] - position[axis_linear])/segments;
-
-    /* Vector rotation by transformation matrix: r is the original vector, r_T is the rotated vector,
-       and phi is the angle of rotation. Solution approach by Jens Geisler.
-           r_T = [cos(phi) -sin(phi);
-                  sin(phi)  cos(phi] * r ;
-
-       For arc generation, the center of the circle is the axis of rotation and the radius vector is
-       defined from the circle center to the initial position. Each line segment is formed by successive
-       vector rotations. Single precision values can accumulate error greater than tool precision in rare
-       cases. So, exact arc path correction is implemented. This approach avoids the problem of too many very
-       expensive trig operations [sin(),cos(),tan()] which can take 100-200 usec each to compute.
-
-       Small angle approximation may be used to reduce computation overhead further. A third-order approximation
-       (second order sin() has too much error) holds for most, if not, all CNC applications. Note that this
-       approximation will begin to accumulate a numerical drift error when theta_per_segment is greater than
-       ~0.25 rad(14 deg) AND the approximation is successively used without correction several dozen times. This
-       scenario is extremely unlikely, since segment lengths and theta_per_segment are automatically generated
-       and scaled by the arc tolerance setting. Only a very large arc tolerance setting, unrealistic for CNC
-       applications, would cause this numerical drift error. However, it is best to set N_ARC_CORRECTION from a
-       low of ~4 to a high of ~20 or so to avoid trig operations while keeping arc generation accurate.
-
-       This approximation also allows mc_arc to immediately insert a line segment into the planner
-       without the initial overhead of computing cos() or sin(). By the time the arc needs to be applied
-       a correction, the planner should have caught up to the lag caused by the initial mc_arc overhead.
-       This is important when there are successive arc motions.
-    */
-    // Computes: cos_T = 1 - theta_per_segment^2/2, sin_T = theta_per_segment - theta_per_segment^3/6) in ~52usec
-    float cos_T = 2.0 - theta_per_segment*theta_per_segment;
-    float sin_T = theta_per_segment*0.16666667*(cos_T + 4.0);
-    cos_T *= 0.5;
-
-    float sin_Ti;
-    float cos_Ti;
-    float r_axisi;
-    uint16_t i;
-    uint8_t count = 0;
 
-    for (i = 1; i<segments; i++) { // Increment (segments-1).
+  // Queues the remaining line segments of an arc. If non-blocking, returns false as soon as the planner
+  // buffer is full, such that the main program may resume the arc later. Returns true when the arc is
+  // complete, or upon a system abort.
+  static uint8_t mc_generate_arc(mc_arc_t *arc, uint8_t is_nonblocking)
+  {
+    float r_axisi;
+    for (; arc->segment < arc->segments; arc->segment++) { // Increment (segments-1).
+      if (is_nonblocking && mc_check_full_buffer()) { return(false); }
 
-      if (count < N_ARC_CORRECTION) {
+      if (arc->count < N_ARC_CORRECTION) {
         // Apply vector rotation matrix. ~40 usec
-        r_axisi = r_axis0*sin_T + r_axis1*cos_T;
-        r_axis0 = r_axis0*cos_T - r_axis1*sin_T;
-        r_axis1 = r_axisi;
-        count++;
+        r_axisi = arc->r_axis0*arc->sin_T + arc->r_axis1*arc->cos_T;
+        arc->r_axis0 = arc->r_axis0*arc->cos_T - arc->r_axis1*arc->sin_T;
+        arc->r_axis1 = r_axisi;
+        arc->count++;
       } else {
         // Arc correction to radius vector. Computed only every N_ARC_CORRECTION increments. ~375 usec
         // Compute exact location by applying transformation matrix from initial radius vector(=-offset).
-        cos_Ti = cos(i*theta_per_segment);
-        sin_Ti = sin(i*theta_per_segment);
-        r_axis0 = -offset[axis_0]*cos_Ti + offset[axis_1]*sin_Ti;
-        r_axis1 = -offset[axis_0]*sin_Ti - offset[axis_1]*cos_Ti;
-        count = 0;
+        float cos_Ti = cos(arc->segment*arc->theta_per_segment);
+        float sin_Ti = sin(arc->segment*arc->theta_per_segment);
+        arc->r_axis0 = -arc->offset_axis0*cos_Ti + arc->offset_axis1*sin_Ti;
+        arc->r_axis1 = -arc->offset_axis0*sin_Ti - arc->offset_axis1*cos_Ti;
+        arc->count = 0;
       }
 
       // Update arc_target location
-      position[axis_0] = center_axis0 + r_axis0;
-      position[axis_1] = center_axis1 + r_axis1;
-      position[axis_linear] += linear_per_segment;
+      arc->position[arc->axis_0] = arc->center_axis0 + arc->r_axis0;
+      arc->position[arc->axis_1] = arc->center_axis1 + arc->r_axis1;
+      if (arc->axis_linear < N_AXIS) { arc->position[arc->axis_linear] += arc->linear_per_segment; }
 
-      mc_line(position, pl_data);
+      mc_line(arc->position, &arc->pl_data);
 
       // Bail mid-circle on system abort. Runtime command check already performed by mc_line.
-      if (sys.abort) { return; }
+      if (sys.abort) { return(true); }
     }
+
+    // Ensure last segment arrives at target location.
+    if (is_nonblocking && mc_check_full_buffer()) { return(false); }
+    mc_line(arc->target, &arc->pl_data);
+    arc->segment++;
+    return(true);
   }
-  // Ensure last segment arrives at target location.
-  mc_line(target, pl_data);
+#endif
+
+
+// Execute an arc in offset mode format. position == current xyz, target == target xyz,
+// offset == offset from current xyz, axis_X defines circle plane in tool space, axis_linear is
+// the direction of helical travel, radius == circle radius, isclockwise boolean. Used
+// for vector transformation direction.
+// The arc is approximated by generating a huge number of tiny, linear segments. The chordal tolerance
+// of each segment is configured in settings.arc_tolerance, which is defined to be the maximum normal
+// distance from segment to the circle when the end points both lie on the circle.
+// With ENABLE_NATIVE_ARC_BLOCKS, the arc is instead queued as a single planner block.
+void mc_arc(float *target, plan_line_data_t *pl_data, float *position, float *offset, float radius,
+  uint8_t axis_0, uint8_t axis_1, uint8_t axis_linear, uint8_t is_clockwise_arc)
+{
+  #ifdef ENABLE_NATIVE_ARC_BLOCKS
+    // Queue the arc as a single planner block. The step segment generator traces the arc path.
+    pl_data->condition |= PL_COND_FLAG_ARC_MOTION;
+    pl_data->arc_offset[0] = offset[axis_0];
+    pl_data->arc_offset[1] = offset[axis_1];
+    pl_data->arc_angular_travel = mc_compute_arc_angular_travel(target, position, offset, axis_0, axis_1, is_clockwise_arc);
+    pl_data->arc_axis_0 = axis_0;
+    pl_data->arc_axis_1 = axis_1;
+    #ifdef PLAN_MAX_BLOCK_STEPS
+      // Compact planner blocks and fixed-point segment prep handle up to PLAN_MAX_BLOCK_STEPS steps per
+      // axis, which also end the arc at its target. Split longer arcs by their arc length into equal
+      // parts about the same center.
+      float max_steps = fabs(pl_data->arc_angular_travel)*radius*max(settings.steps_per_mm[axis_0], settings.steps_per_mm[axis_1]);
+      if (axis_linear < N_AXIS) {
+        max_steps = max(max_steps, fabs(target[axis_linear]-position[axis_linear])*settings.steps_per_mm[axis_linear]);
+      }
+      if (max_steps > (PLAN_MAX_BLOCK_STEPS-1)) {
+        uint16_t parts = max_steps/(PLAN_MAX_BLOCK_STEPS-1) + 1;
+        if (pl_data->condition & PL_COND_FLAG_INVERSE_TIME) { pl_data->feed_rate *= parts; }
+        float center_axis0 = position[axis_0] + offset[axis_0];
+        float center_axis1 = position[axis_1] + offset[axis_1];
+        float angular_travel = pl_data->arc_angular_travel;
+        pl_data->arc_angular_travel = angular_travel/parts;
+        float part_target[N_AXIS];
+        memcpy(part_target, target, sizeof(part_target));
+        uint16_t part;
+        #ifdef ENABLE_FIXED_POINT_COORDINATES
+          // Only the last part ends at the step target. The others are planned from their targets in mm.
+          uint8_t condition = pl_data->condition;
+          pl_data->condition &= ~PL_COND_FLAG_STEP_TARGET;
+        #endif
+        for (part=1; part<parts; part++) {
+          float cos_T = cos(angular_travel*part/parts);
+          float sin_T = sin(angular_travel*part/parts);
+          part_target[axis_0] = center_axis0 - offset[axis_0]*cos_T + offset[axis_1]*sin_T;
+          part_target[axis_1] = center_axis1 - offset[axis_0]*sin_T - offset[axis_1]*cos_T;
+          if (axis_linear < N_AXIS) {
+            part_target[axis_linear] = position[axis_linear] + (target[axis_linear]-position[axis_linear])*part/parts;
+          }
+          mc_line(part_target, pl_data);
+          if (sys.abort) { return; }
+          // Center offset from the start of the next part.
+          pl_data->arc_offset[0] = center_axis0 - part_target[axis_0];
+          pl_data->arc_offset[1] = center_axis1 - part_target[axis_1];
+        }
+        #ifdef ENABLE_FIXED_POINT_COORDINATES
+          pl_data->condition = condition;
+        #endif
+      }
+    #endif
+    mc_line(target, pl_data);
+  #else
+    mc_arc_t arc;
+    mc_init_arc(&arc, target, pl_data, position, offset, radius, axis_0, axis_1, axis_linear, is_clockwise_arc);
+    mc_generate_arc(&arc, false);
+  #endif
 }
 
 
+#ifdef ENABLE_INCREMENTAL_ARCS
+  void mc_start_arc(float *target, plan_line_data_t *pl_data, float *position, float *offset, float radius,
+    uint8_t axis_0, uint8_t axis_1, uint8_t axis_linear, uint8_t is_clockwise_arc)
+  {
+    mc_finish_arc(); // Only one pending arc. Normally already finished by the caller.
+    if (sys.abort) { return; }
+    mc_init_arc(&mc_pending_arc, target, pl_data, position, offset, radius, axis_0, axis_1, axis_linear, is_clockwise_arc);
+    mc_arc_pending = true;
+    mc_execute_arc();
+  }
+
+
+  void mc_execute_arc()
+  {
+    if (mc_arc_pending) {
+      if (mc_generate_arc(&mc_pending_arc, true)) { mc_arc_pending = false; }
+    }
+  }
+
+
+  void mc_finish_arc()
+  {
+    if (mc_arc_pending) {
+      mc_generate_arc(&mc_pending_arc, false);
+      mc_arc_pending = false;
+    }
+  }
+
+
+  void mc_reset_arc() { mc_arc_pending = false; }
+#endif
+
+
 // Execute dwell in seconds.
 void mc_dwell(float seconds)
 {
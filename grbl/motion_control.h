@@ -22,12 +22,33 @@
 #ifndef motion_control_h
 #define motion_control_h
 
+#ifdef ENABLE_PARSE_AHEAD_QUEUE
+  #ifndef PARSE_AHEAD_QUEUE_SIZE
+    #define PARSE_AHEAD_QUEUE_SIZE 4 // Number of line motions queued ahead of the planner buffer.
+  #endif
+#endif
 
 // Execute linear motion in absolute millimeter coordinates. Feed rate given in millimeters/second
 // unless invert_feed_rate is true. Then the feed_rate means that the motion should be completed in
 // (1 minute)/feed_rate time.
 void mc_line(float *target, plan_line_data_t *pl_data);
 
+#ifdef ENABLE_PARSE_AHEAD_QUEUE
+  // Moves queued line motions into the planner buffer, while it has room. Does not block.
+  void mc_execute_queue();
+
+  // Returns true if line motions are queued ahead of the planner buffer.
+  uint8_t mc_check_queue();
+
+  // Discards all queued line motions. Called along with a planner buffer reset.
+  void mc_reset_queue();
+#endif
+
+#ifdef ENABLE_PREPLANNED_BLOCKS
+  // Execute a host-planned block. Returns a status code, as the block data is not checked otherwise.
+  uint8_t mc_host_block(plan_host_block_t *host_block);
+#endif
+
 // Execute an arc in offset mode format. position == current xyz, target == target xyz,
 // offset == offset from current xyz, axis_XXX defines circle plane in tool space, axis_linear is
 // the direction of helical travel, radius == circle radius, is_clockwise_arc boolean. Used
@@ -35,6 +56,22 @@ void mc_line(float *target, plan_line_data_t *pl_data);
 void mc_arc(float *target, plan_line_data_t *pl_data, float *position, float *offset, float radius,
   uint8_t axis_0, uint8_t axis_1, uint8_t axis_linear, uint8_t is_clockwise_arc);
 
+#ifdef ENABLE_INCREMENTAL_ARCS
+  // Starts an arc, as mc_arc(), but only queues line segments while the planner buffer has room.
+  // The rest are queued by mc_execute_arc() or mc_finish_arc().
+  void mc_start_arc(float *target, plan_line_data_t *pl_data, float *position, float *offset, float radius,
+    uint8_t axis_0, uint8_t axis_1, uint8_t axis_linear, uint8_t is_clockwise_arc);
+
+  // Queues line segments of the started arc, while the planner buffer has room. Does not block.
+  void mc_execute_arc();
+
+  // Queues all remaining line segments of the started arc. Called before any other motion.
+  void mc_finish_arc();
+
+  // Discards the remaining line segments of the started arc. Called along with a planner buffer reset.
+  void mc_reset_arc();
+#endif
+
 // Dwell for a specific number of seconds
 void mc_dwell(float seconds);
 
@@ -108,6 +108,79 @@ uint8_t read_float(char *line, uint8_t *char_counter, float *float_ptr)
 }
 
 
+#ifdef ENABLE_FIXED_POINT_COORDINATES
+  // Extracts a decimal value from a string as a fixed-point integer, like read_float() but without
+  // any floating point operations. Digits beyond FIXED_POINT_DIGITS decimals are rounded half away
+  // from zero. Values beyond FIXED_POINT_MAX are rejected, instead of dropping overflow digits.
+  uint8_t read_fixed(char *line, uint8_t *char_counter, int32_t *fixed_ptr)
+  {
+    char *ptr = line + *char_counter;
+    unsigned char c;
+
+    // Grab first character and increment pointer. No spaces assumed in line.
+    c = *ptr++;
+
+    // Capture initial positive/minus character
+    bool isnegative = false;
+    if (c == '-') {
+      isnegative = true;
+      c = *ptr++;
+    } else if (c == '+') {
+      c = *ptr++;
+    }
+
+    // Extract number into integer, up to the fixed-point decimals. Track the decimals read.
+    uint32_t intval = 0;
+    int8_t ndecimal = -1; // Negative until the decimal point.
+    uint8_t ndigit = 0;
+    bool isroundup = false;
+    while(1) {
+      c -= '0';
+      if (c <= 9) {
+        ndigit++;
+        if (ndecimal < FIXED_POINT_DIGITS) {
+          if (intval > FIXED_POINT_MAX/10) { return(false); }
+          intval = (((intval << 2) + intval) << 1) + c; // intval*10 + c
+          if (ndecimal >= 0) { ndecimal++; }
+        } else if (ndecimal == FIXED_POINT_DIGITS) {
+          isroundup = (c >= 5); // First dropped decimal rounds. The rest are ignored.
+          ndecimal++;
+        }
+      } else if (c == (('.'-'0') & 0xff)  &&  (ndecimal < 0)) {
+        ndecimal = 0;
+      } else {
+        break;
+      }
+      c = *ptr++;
+    }
+
+    // Return if no digits have been read.
+    if (!ndigit) { return(false); };
+
+    // Scale the integer to the fixed-point decimals.
+    if (ndecimal < 0) { ndecimal = 0; }
+    while (ndecimal < FIXED_POINT_DIGITS) {
+      if (intval > FIXED_POINT_MAX/10) { return(false); }
+      intval = (((intval << 2) + intval) << 1); // intval*10
+      ndecimal++;
+    }
+    if (isroundup) { intval++; }
+    if (intval > FIXED_POINT_MAX) { return(false); }
+
+    // Assign fixed-point value with correct sign.
+    if (isnegative) {
+      *fixed_ptr = -(int32_t)intval;
+    } else {
+      *fixed_ptr = intval;
+    }
+
+    *char_counter = ptr - line - 1; // Set char_counter to next statement
+
+    return(true);
+  }
+#endif
+
+
 // Non-blocking delay function used for general operation and suspend features.
 void delay_sec(float seconds, uint8_t mode)
 {
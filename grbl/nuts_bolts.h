@@ -36,6 +36,45 @@
 #if N_AXIS > 2
   #define Z_AXIS 2
 #endif
+#if N_AXIS > 3
+  #define A_AXIS 3
+#endif
+#if N_AXIS > 4
+  #define B_AXIS 4
+#endif
+#if N_AXIS > 5
+  #define C_AXIS 5
+#endif
+
+// Axis table. Expands the macro m(axis,step_bit,direction_bit) for each axis in index order, such
+// that per-axis code is generated at compile time for any number of axes. The step and direction
+// bits of each axis are defined in the cpu map.
+#ifdef Z_AXIS
+  #define AXIS_TABLE_Z(m) m(Z_AXIS,Z_STEP_BIT,Z_DIRECTION_BIT)
+#else
+  #define AXIS_TABLE_Z(m)
+#endif
+#ifdef A_AXIS
+  #define AXIS_TABLE_A(m) m(A_AXIS,A_STEP_BIT,A_DIRECTION_BIT)
+#else
+  #define AXIS_TABLE_A(m)
+#endif
+#ifdef B_AXIS
+  #define AXIS_TABLE_B(m) m(B_AXIS,B_STEP_BIT,B_DIRECTION_BIT)
+#else
+  #define AXIS_TABLE_B(m)
+#endif
+#ifdef C_AXIS
+  #define AXIS_TABLE_C(m) m(C_AXIS,C_STEP_BIT,C_DIRECTION_BIT)
+#else
+  #define AXIS_TABLE_C(m)
+#endif
+#define AXIS_TABLE(m) m(X_AXIS,X_STEP_BIT,X_DIRECTION_BIT) m(Y_AXIS,Y_STEP_BIT,Y_DIRECTION_BIT) \
+                      AXIS_TABLE_Z(m) AXIS_TABLE_A(m) AXIS_TABLE_B(m) AXIS_TABLE_C(m)
+
+// Axis table expansions of the step and direction pin masks of all axes. Used as (0 AXIS_TABLE(m)).
+#define AXIS_STEP_PIN_BIT(axis,step_bit,direction_bit) |(1<<(step_bit))
+#define AXIS_DIRECTION_PIN_BIT(axis,step_bit,direction_bit) |(1<<(direction_bit))
 
 // Conversions
 #define TICKS_PER_MICROSECOND (F_CPU/1000000)
@@ -63,6 +102,16 @@
 // a pointer to the result variable. Returns true when it succeeds
 uint8_t read_float(char *line, uint8_t *char_counter, float *float_ptr);
 
+#ifdef ENABLE_FIXED_POINT_COORDINATES
+  #define FIXED_POINT_DIGITS 4            // Decimal digits of fixed-point coordinates
+  #define FIXED_POINT_SCALE 10000         // Fixed-point units per mm. Must equal 10^FIXED_POINT_DIGITS.
+  #define FIXED_POINT_MAX 1000000000UL    // Maximum fixed-point value magnitude (100000mm)
+
+  // Read a decimal value from a string as a fixed-point integer in 1/FIXED_POINT_SCALE units.
+  // Returns true when it succeeds and the value is within FIXED_POINT_MAX.
+  uint8_t read_fixed(char *line, uint8_t *char_counter, int32_t *fixed_ptr);
+#endif
+
 // Non-blocking delay function used for general operation and suspend features.
 void delay_sec(float seconds, uint8_t mode);
 
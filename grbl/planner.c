@@ -29,6 +29,13 @@ static uint8_t block_buffer_head;     // Index of the next block to be pushed
 static uint8_t next_buffer_head;      // Index of the next buffer head
 static uint8_t block_buffer_planned;  // Index of the optimally planned block
 
+#ifdef USE_SPLIT_PLANNER_PROFILES
+  static plan_profile_t block_profile[BLOCK_BUFFER_SIZE]; // Velocity profile data of each block in block_buffer
+  #define plan_block_profile(block_index) (&block_profile[block_index])
+#else
+  #define plan_block_profile(block_index) (&block_buffer[block_index].profile)
+#endif
+
 // Define planner variables
 typedef struct {
   int32_t position[N_AXIS];          // The planner position of the tool in absolute steps. Kept separate
@@ -36,9 +43,72 @@ typedef struct {
                                      // i.e. arcs, canned cycles, and backlash compensation.
   float previous_unit_vec[N_AXIS];   // Unit vector of previous path line segment
   float previous_nominal_speed;  // Nominal speed of previous path line segment
+  #if defined(ENABLE_BLOCK_MERGING) || defined(ENABLE_PATH_BLENDING)
+    // Planner state prior to the last queued block, such that it may be re-planned with a merged motion
+    // or a blended corner.
+    int32_t merge_position[N_AXIS];  // Start position of the last queued block in absolute steps
+    float merge_unit_vec[N_AXIS];    // Previous path unit vector prior to the last queued block
+    float merge_nominal_speed;       // Previous nominal speed prior to the last queued block
+  #endif
+  #ifdef ENABLE_BLOCK_MERGING
+    float merge_deviation;           // Maximum path deviation of the last queued block (mm)
+  #endif
+  #ifdef ENABLE_LAZY_OVERRIDE_REPLAN
+    uint8_t override_pending;        // Flags an override change not yet applied to the buffered blocks
+  #endif
+  #ifdef ENABLE_PREPLANNED_BLOCKS
+    float host_exit_speed_sqr;       // Host-planned exit speed of the last queued host-planned block
+  #endif
 } planner_t;
 static planner_t pl;
 
+#ifdef JUNCTION_FACTOR_TABLE_SIZE
+  // The junction factor sin(theta/2)/(1-sin(theta/2)) equals h(u)/u, where u = 1+cos(theta) and
+  // h(u) = 2*s*(1+s) with s = sin(theta/2) = sqrt(1-u/2). h(u) is smooth and concave over u = [0,2],
+  // so linearly interpolating it from a table never exceeds the exact value.
+  #define JUNCTION_FACTOR_SCALE 16383.0 // h(u) ranges from 4 to 0. Stored as 2.14 fixed-point.
+
+  // The table is computed by the compiler and stored in flash. Entry i holds h(2*i/size), truncated
+  // so that it rounds down. The entry lists double in length, such that any size is composed from
+  // the set bits of the table size.
+  #define JF_S(i) __builtin_sqrt(1.0-(double)(i)/JUNCTION_FACTOR_TABLE_SIZE)
+  #define JF_ENTRY(i) ((uint16_t)(2.0*JF_S(i)*(1.0+JF_S(i))*JUNCTION_FACTOR_SCALE))
+  #define JF_ENTRIES_1(i) JF_ENTRY(i),
+  #define JF_ENTRIES_2(i) JF_ENTRIES_1(i) JF_ENTRIES_1((i)+1)
+  #define JF_ENTRIES_4(i) JF_ENTRIES_2(i) JF_ENTRIES_2((i)+2)
+  #define JF_ENTRIES_8(i) JF_ENTRIES_4(i) JF_ENTRIES_4((i)+4)
+  #define JF_ENTRIES_16(i) JF_ENTRIES_8(i) JF_ENTRIES_8((i)+8)
+  #define JF_ENTRIES_32(i) JF_ENTRIES_16(i) JF_ENTRIES_16((i)+16)
+  #define JF_ENTRIES_64(i) JF_ENTRIES_32(i) JF_ENTRIES_32((i)+32)
+  static const __flash uint16_t junction_factor_table[JUNCTION_FACTOR_TABLE_SIZE+1] = {
+    #if (JUNCTION_FACTOR_TABLE_SIZE & 128)
+      JF_ENTRIES_64(0) JF_ENTRIES_64(64)
+    #endif
+    #if (JUNCTION_FACTOR_TABLE_SIZE & 64)
+      JF_ENTRIES_64(JUNCTION_FACTOR_TABLE_SIZE & 0x80)
+    #endif
+    #if (JUNCTION_FACTOR_TABLE_SIZE & 32)
+      JF_ENTRIES_32(JUNCTION_FACTOR_TABLE_SIZE & 0xc0)
+    #endif
+    #if (JUNCTION_FACTOR_TABLE_SIZE & 16)
+      JF_ENTRIES_16(JUNCTION_FACTOR_TABLE_SIZE & 0xe0)
+    #endif
+    #if (JUNCTION_FACTOR_TABLE_SIZE & 8)
+      JF_ENTRIES_8(JUNCTION_FACTOR_TABLE_SIZE & 0xf0)
+    #endif
+    #if (JUNCTION_FACTOR_TABLE_SIZE & 4)
+      JF_ENTRIES_4(JUNCTION_FACTOR_TABLE_SIZE & 0xf8)
+    #endif
+    #if (JUNCTION_FACTOR_TABLE_SIZE & 2)
+      JF_ENTRIES_2(JUNCTION_FACTOR_TABLE_SIZE & 0xfc)
+    #endif
+    #if (JUNCTION_FACTOR_TABLE_SIZE & 1)
+      JF_ENTRIES_1(JUNCTION_FACTOR_TABLE_SIZE & 0xfe)
+    #endif
+    JF_ENTRY(JUNCTION_FACTOR_TABLE_SIZE)
+  };
+#endif
+
 
 // Returns the index of the next block in the ring buffer. Also called by stepper segment buffer.
 uint8_t plan_next_block_index(uint8_t block_index)
@@ -125,6 +195,13 @@ static uint8_t plan_prev_block_index(uint8_t block_index)
 */
 static void planner_recalculate()
 {
+  #ifdef ENABLE_MAIN_LOOP_TELEMETRY
+    if (sys.state == STATE_CYCLE) {
+      uint8_t block_count = plan_get_block_buffer_count();
+      if (block_count < sys_telemetry.planner_low_water) { sys_telemetry.planner_low_water = block_count; }
+    }
+  #endif
+
   // Initialize block index to the last block in the planner buffer.
   uint8_t block_index = plan_prev_block_index(block_buffer_head);
 
@@ -135,8 +212,8 @@ static void planner_recalculate()
   // block in buffer. Cease planning when the last optimal planned or tail pointer is reached.
   // NOTE: Forward pass will later refine and correct the reverse pass to create an optimal plan.
   float entry_speed_sqr;
-  plan_block_t *next;
-  plan_block_t *current = &block_buffer[block_index];
+  plan_profile_t *next;
+  plan_profile_t *current = plan_block_profile(block_index);
 
   // Calculate maximum entry speed for last block in buffer, where the exit speed is always zero.
   current->entry_speed_sqr = min( current->max_entry_speed_sqr, 2*current->acceleration*current->millimeters);
@@ -148,7 +225,7 @@ static void planner_recalculate()
   } else { // Three or more plan-able blocks
     while (block_index != block_buffer_planned) {
       next = current;
-      current = &block_buffer[block_index];
+      current = plan_block_profile(block_index);
       block_index = plan_prev_block_index(block_index);
 
       // Check if next block is the tail block(=planned block). If so, update current stepper parameters.
@@ -168,11 +245,11 @@ static void planner_recalculate()
 
   // Forward Pass: Forward plan the acceleration curve from the planned pointer onward.
   // Also scans for optimal plan breakpoints and appropriately updates the planned pointer.
-  next = &block_buffer[block_buffer_planned]; // Begin at buffer planned pointer
+  next = plan_block_profile(block_buffer_planned); // Begin at buffer planned pointer
   block_index = plan_next_block_index(block_buffer_planned);
   while (block_index != block_buffer_head) {
     current = next;
-    next = &block_buffer[block_index];
+    next = plan_block_profile(block_index);
 
     // Any acceleration detected in the forward pass automatically moves the optimal planned
     // pointer forward, since everything before this is all optimal. In other words, nothing
@@ -196,6 +273,20 @@ static void planner_recalculate()
 }
 
 
+#ifdef JUNCTION_FACTOR_TABLE_SIZE
+  // Returns the junction factor for u = 1+cos(theta) in (0,2), interpolated from the table.
+  static float plan_get_junction_factor(float u)
+  {
+    float x = u*(0.5*JUNCTION_FACTOR_TABLE_SIZE);
+    uint8_t idx = x;
+    if (idx >= JUNCTION_FACTOR_TABLE_SIZE) { idx = JUNCTION_FACTOR_TABLE_SIZE-1; }
+    float h = junction_factor_table[idx];
+    h += (x-idx)*((float)junction_factor_table[idx+1]-h);
+    return(h*(1.0/JUNCTION_FACTOR_SCALE)/u);
+  }
+#endif
+
+
 void plan_reset()
 {
   memset(&pl, 0, sizeof(planner_t)); // Clear planner struct
@@ -238,11 +329,22 @@ plan_block_t *plan_get_current_block()
 }
 
 
+// Returns address of the velocity profile data of a planner block. Called by segment generator.
+plan_profile_t *plan_get_block_profile(plan_block_t *block)
+{
+  #ifdef USE_SPLIT_PLANNER_PROFILES
+    return(&block_profile[block-block_buffer]);
+  #else
+    return(&block->profile);
+  #endif
+}
+
+
 float plan_get_exec_block_exit_speed_sqr()
 {
   uint8_t block_index = plan_next_block_index(block_buffer_tail);
   if (block_index == block_buffer_head) { return( 0.0 ); }
-  return( block_buffer[block_index].entry_speed_sqr );
+  return( plan_block_profile(block_index)->entry_speed_sqr );
 }
 
 
@@ -254,14 +356,15 @@ uint8_t plan_check_full_buffer()
 }
 
 
-// Computes and returns block nominal speed based on running condition and override values.
+// Computes and returns block nominal speed based on running condition and the given feed and rapid
+// override values in percent.
 // NOTE: All system motion commands are not subject to overrides.
-float plan_compute_profile_nominal_speed(plan_block_t *block)
+float plan_compute_profile_override_speed(plan_block_t *block, float f_override, float r_override)
 {
   float nominal_speed = block->programmed_rate;
-  if (block->condition & PL_COND_FLAG_RAPID_MOTION) { nominal_speed *= (0.01*sys.r_override); }
+  if (block->condition & PL_COND_FLAG_RAPID_MOTION) { nominal_speed *= (0.01*r_override); }
   else {
-    if (!(block->condition & PL_COND_FLAG_NO_FEED_OVERRIDE)) { nominal_speed *= (0.01*sys.f_override); }
+    if (!(block->condition & PL_COND_FLAG_NO_FEED_OVERRIDE)) { nominal_speed *= (0.01*f_override); }
     if (nominal_speed > block->rapid_rate) { nominal_speed = block->rapid_rate; }
   }
   if (nominal_speed > MINIMUM_FEED_RATE) { return(nominal_speed); }
@@ -269,14 +372,48 @@ float plan_compute_profile_nominal_speed(plan_block_t *block)
 }
 
 
+// Computes and returns block nominal speed based on running condition and override values.
+float plan_compute_profile_nominal_speed(plan_block_t *block)
+{
+  #ifdef ENABLE_CONTINUOUS_OVERRIDES
+    // While an override slews down, plan with the executed value. The segment generator then never
+    // executes faster than the plan, which keeps every planned deceleration reachable.
+    if (settings.override_slew_rate > 0.0) {
+      return(plan_compute_profile_override_speed(block, max(sys.f_override, st_get_executed_feed_override()),
+                                                 max(sys.r_override, st_get_executed_rapid_override())));
+    }
+  #endif
+  return(plan_compute_profile_override_speed(block, sys.f_override, sys.r_override));
+}
+
+
+#ifdef USE_COMPACT_PLANNER_BLOCKS
+  // Converts a rate limit to the whole mm/min of compact blocks. Rounds down to remain conservative.
+  static uint16_t plan_compact_rate(float rate)
+  {
+    if (rate >= PLAN_MAX_BLOCK_RATE) { return(PLAN_MAX_BLOCK_RATE); }
+    return((uint16_t)rate);
+  }
+#endif
+
+
 // Computes and updates the max entry speed (sqr) of the block, based on the minimum of the junction's
 // previous and current nominal speeds and max junction speed.
-static void plan_compute_profile_parameters(plan_block_t *block, float nominal_speed, float prev_nominal_speed)
+static void plan_compute_profile_parameters(uint8_t block_index, float nominal_speed, float prev_nominal_speed)
 {
+  plan_block_t *block = &block_buffer[block_index];
+  plan_profile_t *profile = plan_block_profile(block_index);
+
   // Compute the junction maximum entry based on the minimum of the junction speed and neighboring nominal speeds.
-  if (nominal_speed > prev_nominal_speed) { block->max_entry_speed_sqr = prev_nominal_speed*prev_nominal_speed; }
-  else { block->max_entry_speed_sqr = nominal_speed*nominal_speed; }
-  if (block->max_entry_speed_sqr > block->max_junction_speed_sqr) { block->max_entry_speed_sqr = block->max_junction_speed_sqr; }
+  if (nominal_speed > prev_nominal_speed) { profile->max_entry_speed_sqr = prev_nominal_speed*prev_nominal_speed; }
+  else { profile->max_entry_speed_sqr = nominal_speed*nominal_speed; }
+  #ifdef USE_COMPACT_PLANNER_BLOCKS
+    float max_junction_speed = block->max_junction_speed;
+    float max_junction_speed_sqr = max_junction_speed*max_junction_speed;
+  #else
+    float max_junction_speed_sqr = block->max_junction_speed_sqr;
+  #endif
+  if (profile->max_entry_speed_sqr > max_junction_speed_sqr) { profile->max_entry_speed_sqr = max_junction_speed_sqr; }
 }
 
 
@@ -284,20 +421,211 @@ static void plan_compute_profile_parameters(plan_block_t *block, float nominal_s
 void plan_update_velocity_profile_parameters()
 {
   uint8_t block_index = block_buffer_tail;
-  plan_block_t *block;
   float nominal_speed;
   float prev_nominal_speed = SOME_LARGE_VALUE; // Set high for first block nominal speed calculation.
   while (block_index != block_buffer_head) {
-    block = &block_buffer[block_index];
-    nominal_speed = plan_compute_profile_nominal_speed(block);
-    plan_compute_profile_parameters(block, nominal_speed, prev_nominal_speed);
+    nominal_speed = plan_compute_profile_nominal_speed(&block_buffer[block_index]);
+    plan_compute_profile_parameters(block_index, nominal_speed, prev_nominal_speed);
     prev_nominal_speed = nominal_speed;
     block_index = plan_next_block_index(block_index);
   }
   pl.previous_nominal_speed = prev_nominal_speed; // Update prev nominal speed for next incoming block.
+  #ifdef ENABLE_LAZY_OVERRIDE_REPLAN
+    pl.override_pending = false;
+  #endif
+}
+
+
+#ifdef ENABLE_LAZY_OVERRIDE_REPLAN
+  // Defers the re-plan upon a motion-based override change. Only flags the executing block for the
+  // segment generator to re-compute its profile with the new nominal speed.
+  void plan_defer_velocity_profile_update()
+  {
+    pl.override_pending = true;
+    st_update_plan_block_parameters();
+  }
+
+
+  // Returns true, if an override change has not yet been applied to the buffered blocks.
+  uint8_t plan_check_override_pending()
+  {
+    return(pl.override_pending);
+  }
+
+
+  // Applies a deferred override change to the buffered blocks and re-plans them. Called by the segment
+  // generator before it loads the tail block, which enters at the exit speed of the previous block.
+  // NOTE: The previous block may exit below the planned entry speed, if its exit was limited to the
+  // new nominal speed. Hence, the tail block entry speed is reset prior to re-planning.
+  void plan_apply_velocity_profile_update(float entry_speed)
+  {
+    plan_update_velocity_profile_parameters();
+    if (block_buffer_head == block_buffer_tail) { return; } // Buffer empty. Nothing to re-plan.
+    plan_block_profile(block_buffer_tail)->entry_speed_sqr = entry_speed*entry_speed;
+    block_buffer_planned = block_buffer_tail;
+    planner_recalculate();
+  }
+#endif
+
+
+#ifdef ENABLE_NATIVE_ARC_BLOCKS
+  // Computes the path length and direction vectors of a native arc block. On input, unit_vec holds the
+  // axis travel of the block (mm). On return, unit_vec holds the largest fraction of the path speed
+  // each axis may see along the arc, where the arc plane axes are fully aligned with the path at some
+  // point, for limiting the block acceleration and rates. The arc entry and exit unit vectors are
+  // tangent to the arc and used for the junction speeds with the adjacent blocks.
+  static float plan_compute_arc_geometry(plan_block_t *block, plan_line_data_t *pl_data, float *unit_vec,
+    float *entry_unit_vec, float *exit_unit_vec)
+  {
+    uint8_t axis_0 = block->arc_axis_0 = pl_data->arc_axis_0;
+    uint8_t axis_1 = block->arc_axis_1 = pl_data->arc_axis_1;
+    float offset_0 = block->arc_offset[0] = pl_data->arc_offset[0];
+    float offset_1 = block->arc_offset[1] = pl_data->arc_offset[1];
+    float angular_travel = block->arc_angular_travel = pl_data->arc_angular_travel;
+
+    // Path length of the helix formed by the arc and the linear travel of all other axes.
+    float arc_mm = fabs(angular_travel)*hypot_f(offset_0, offset_1);
+    float millimeters = arc_mm*arc_mm;
+    uint8_t idx;
+    for (idx=0; idx<N_AXIS; idx++) {
+      if ((idx != axis_0) && (idx != axis_1)) { millimeters += unit_vec[idx]*unit_vec[idx]; }
+    }
+    millimeters = sqrt(millimeters);
+    float inv_mm = 1.0/millimeters;
+
+    // Tangents are the radius vectors from the arc center rotated a quarter turn in the arc direction,
+    // where the start radius vector is the negative offset and the end radius vector is the plane
+    // travel less the offset.
+    float tangent_scalar = angular_travel*inv_mm;
+    float end_radius_0 = unit_vec[axis_0]-offset_0;
+    float end_radius_1 = unit_vec[axis_1]-offset_1;
+    for (idx=0; idx<N_AXIS; idx++) {
+      entry_unit_vec[idx] = exit_unit_vec[idx] = unit_vec[idx]*inv_mm;
+      unit_vec[idx] = fabs(entry_unit_vec[idx]);
+    }
+    entry_unit_vec[axis_0] = tangent_scalar*offset_1;
+    entry_unit_vec[axis_1] = -tangent_scalar*offset_0;
+    exit_unit_vec[axis_0] = -tangent_scalar*end_radius_1;
+    exit_unit_vec[axis_1] = tangent_scalar*end_radius_0;
+    unit_vec[axis_0] = unit_vec[axis_1] = arc_mm*inv_mm;
+    return(millimeters);
+  }
+#endif
+
+
+// Returns the target position of axis 'idx' of a new line motion in absolute steps.
+static int32_t plan_compute_target_steps(float *target, plan_line_data_t *pl_data, uint8_t idx)
+{
+  #ifdef ENABLE_FIXED_POINT_COORDINATES
+    if (pl_data->condition & PL_COND_FLAG_STEP_TARGET) { return(pl_data->target_steps[idx]); }
+  #endif
+  return(lround(target[idx]*settings.steps_per_mm[idx]));
 }
 
 
+#if defined(ENABLE_BLOCK_MERGING) || defined(ENABLE_PATH_BLENDING)
+  // Checks if the last queued block may be removed and re-planned together with the new line motion
+  // in pl_data. It must be a line motion with the same run conditions, which the stepper segment
+  // generator has not yet loaded.
+  static uint8_t plan_check_last_block(plan_line_data_t *pl_data)
+  {
+    if (block_buffer_head == block_buffer_tail) { return(false); }
+    uint8_t block_index = plan_prev_block_index(block_buffer_head);
+    if (block_index == block_buffer_tail) { return(false); }
+    plan_block_t *block = &block_buffer[block_index];
+    if (pl_data->condition & (PL_COND_FLAG_SYSTEM_MOTION | PL_COND_FLAG_INVERSE_TIME | PL_COND_FLAG_ARC_MOTION)) { return(false); }
+    if ((block->condition ^ pl_data->condition) & ~PL_COND_FLAG_STEP_TARGET) { return(false); } // Same up to the target format.
+    if (!(block->condition & PL_COND_FLAG_RAPID_MOTION) && (block->programmed_rate != pl_data->feed_rate)) { return(false); }
+    return(true);
+  }
+
+
+  // Removes the last queued block and restores the planner state prior to it. The block planned in
+  // its place has its entry speed re-planned from the preceding block. Also called by mc_line() for
+  // path blending, after plan_get_last_line_start() returned true.
+  void plan_remove_last_block()
+  {
+    uint8_t block_index = plan_prev_block_index(block_buffer_head);
+    block_buffer_head = block_index;
+    next_buffer_head = plan_next_block_index(block_buffer_head);
+    if (block_buffer_planned == block_index) { block_buffer_planned = plan_prev_block_index(block_index); }
+    memcpy(pl.position, pl.merge_position, sizeof(pl.position));
+    memcpy(pl.previous_unit_vec, pl.merge_unit_vec, sizeof(pl.previous_unit_vec));
+    pl.previous_nominal_speed = pl.merge_nominal_speed;
+  }
+#endif
+
+
+#ifdef ENABLE_PATH_BLENDING
+  // Checks if the last queued block may be replaced to blend its corner with the new line motion in
+  // pl_data. If so, returns true and the start position of the block in machine coordinates (mm). With
+  // line numbers, also sets the line number in pl_data to that of the block, for its replacement line.
+  uint8_t plan_get_last_line_start(float *start, plan_line_data_t *pl_data)
+  {
+    if (!plan_check_last_block(pl_data)) { return(false); }
+    system_convert_array_steps_to_mpos(start, pl.merge_position);
+    #ifdef USE_LINE_NUMBERS
+      pl_data->line_number = block_buffer[plan_prev_block_index(block_buffer_head)].line_number;
+    #endif
+    return(true);
+  }
+#endif
+
+
+#ifdef ENABLE_BLOCK_MERGING
+  // Checks if a new line motion may be merged with the last queued block into a single line from the
+  // start of the last block to the new target. If so, removes the last block from the buffer and
+  // restores the planner state prior to it, such that the merged motion is planned in its place.
+  // Returns the maximum path deviation of the merged motion, which bounds the deviation of all motions
+  // merged so far. Otherwise, returns a negative value.
+  static float plan_merge_last_block(float *target, plan_line_data_t *pl_data)
+  {
+    // Only merge into a queued block, which the stepper segment generator has not yet loaded.
+    if (!plan_check_last_block(pl_data)) { return(-1.0); }
+    #ifdef USE_LINE_NUMBERS
+      // Merged motions report the line number of the first one. Keep the line numbers exact.
+      if (block_buffer[plan_prev_block_index(block_buffer_head)].line_number != pl_data->line_number) { return(-1.0); }
+    #endif
+
+    // Compute the last block travel and the new motion travel (mm).
+    float last_delta[N_AXIS], delta[N_AXIS];
+    float last_mm_sqr = 0.0, chord_mm_sqr = 0.0, delta_mm_sqr = 0.0;
+    float last_dot_chord = 0.0, delta_dot_unit_vec = 0.0;
+    uint8_t idx;
+    for (idx=0; idx<N_AXIS; idx++) {
+      int32_t target_steps = plan_compute_target_steps(target, pl_data, idx);
+      #ifdef PLAN_MAX_BLOCK_STEPS
+        // The merged line must fit the step counts of a compact block or fixed-point segment prep.
+        if (labs(target_steps-pl.merge_position[idx]) > PLAN_MAX_BLOCK_STEPS) { return(-1.0); }
+      #endif
+      last_delta[idx] = (pl.position[idx]-pl.merge_position[idx])/settings.steps_per_mm[idx];
+      delta[idx] = (target_steps-pl.position[idx])/settings.steps_per_mm[idx];
+      float chord = last_delta[idx]+delta[idx];
+      last_mm_sqr += last_delta[idx]*last_delta[idx];
+      chord_mm_sqr += chord*chord;
+      delta_mm_sqr += delta[idx]*delta[idx];
+      last_dot_chord += last_delta[idx]*chord;
+      delta_dot_unit_vec += delta[idx]*pl.previous_unit_vec[idx];
+    }
+    if ((delta_mm_sqr == 0.0) || (last_dot_chord <= 0.0)) { return(-1.0); }
+
+    // Check the direction change against the last block, which may already be a merged line.
+    if (delta_dot_unit_vec < cos(BLOCK_MERGE_MAX_ANGLE)*sqrt(delta_mm_sqr)) { return(-1.0); }
+
+    // The merged path deviates most at the end of the last block. Add the deviation of the motions
+    // already merged into the last block, which conservatively bounds the total path deviation.
+    float deviation_sqr = last_mm_sqr - last_dot_chord*last_dot_chord/chord_mm_sqr;
+    float deviation = pl.merge_deviation;
+    if (deviation_sqr > 0.0) { deviation += sqrt(deviation_sqr); }
+    if (deviation > BLOCK_MERGE_TOLERANCE) { return(-1.0); }
+
+    // Remove the last block and restore the planner state. The merged block replaces it.
+    plan_remove_last_block();
+    return(deviation);
+  }
+#endif
+
+
 /* Add a new linear movement to the buffer. target[N_AXIS] is the signed, absolute target position
    in millimeters. Feed rate specifies the speed of the motion. If feed rate is inverted, the feed
    rate is taken to mean "frequency" and would complete the operation in 1/feed_rate minutes.
@@ -314,9 +642,17 @@ void plan_update_velocity_profile_parameters()
    to execute the special system motion. */
 uint8_t plan_buffer_line(float *target, plan_line_data_t *pl_data)
 {
+  #ifdef ENABLE_BLOCK_MERGING
+    float merge_deviation = plan_merge_last_block(target, pl_data);
+  #endif
+
   // Prepare and initialize new block. Copy relevant pl_data for block execution.
   plan_block_t *block = &block_buffer[block_buffer_head];
+  plan_profile_t *profile = plan_block_profile(block_buffer_head);
   memset(block,0,sizeof(plan_block_t)); // Zero all block values.
+  #ifdef USE_SPLIT_PLANNER_PROFILES
+    memset(profile,0,sizeof(plan_profile_t));
+  #endif
   block->condition = pl_data->condition;
   #ifdef USE_LINE_NUMBERS
     block->line_number = pl_data->line_number;
@@ -329,14 +665,18 @@ uint8_t plan_buffer_line(float *target, plan_line_data_t *pl_data)
 
   // Copy position data based on type of motion being planned.
   if (block->condition & PL_COND_FLAG_SYSTEM_MOTION) {
-    memcpy(position_steps, sys_position, sizeof(sys_position));
+    #ifdef USE_SEGMENT_POSITION_COUNTERS
+      st_get_position(position_steps);
+    #else
+      memcpy(position_steps, sys_position, sizeof(sys_position));
+    #endif
   } else { memcpy(position_steps, pl.position, sizeof(pl.position)); }
 
   for (idx=0; idx<N_AXIS; idx++) {
     // Calculate target position in absolute steps, number of steps for each axis, and determine max step events.
     // Also, compute individual axes distance for move and prep unit vector calculations.
     // NOTE: Computes true distance from converted step values.
-    target_steps[idx] = lround(target[idx]*settings.steps_per_mm[idx]);
+    target_steps[idx] = plan_compute_target_steps(target, pl_data, idx);
     block->steps[idx] = labs(target_steps[idx]-position_steps[idx]);
     block->step_event_count = max(block->step_event_count, block->steps[idx]);
     delta_mm = (target_steps[idx] - position_steps[idx])/settings.steps_per_mm[idx];
@@ -346,31 +686,75 @@ uint8_t plan_buffer_line(float *target, plan_line_data_t *pl_data)
     if (delta_mm < 0.0 ) { block->direction_bits |= get_direction_pin_mask(idx); }
   }
 
-  // Bail if this is a zero-length block. Highly unlikely to occur.
-  if (block->step_event_count == 0) { return(PLAN_EMPTY_BLOCK); }
+  #ifdef ENABLE_NATIVE_ARC_BLOCKS
+    // Bail if this is a zero-length block. Highly unlikely to occur. Full circle arcs have no steps.
+    if ((block->step_event_count == 0) && !(block->condition & PL_COND_FLAG_ARC_MOTION)) { return(PLAN_EMPTY_BLOCK); }
+
+    float arc_entry_unit_vec[N_AXIS], arc_exit_unit_vec[N_AXIS];
+    if (block->condition & PL_COND_FLAG_ARC_MOTION) {
+      profile->millimeters = plan_compute_arc_geometry(block, pl_data, unit_vec, arc_entry_unit_vec, arc_exit_unit_vec);
+    } else
+  #else
+    // Bail if this is a zero-length block. Highly unlikely to occur.
+    if (block->step_event_count == 0) { return(PLAN_EMPTY_BLOCK); }
+  #endif
 
   // Calculate the unit vector of the line move and the block maximum feed rate and acceleration scaled
   // down such that no individual axes maximum values are exceeded with respect to the line direction.
   // NOTE: This calculation assumes all axes are orthogonal (Cartesian) and works with ABC-axes,
   // if they are also orthogonal/independent. Operates on the absolute value of the unit vector.
-  block->millimeters = convert_delta_vector_to_unit_vector(unit_vec);
-  block->acceleration = limit_value_by_axis_maximum(settings.acceleration, unit_vec);
-  block->rapid_rate = limit_value_by_axis_maximum(settings.max_rate, unit_vec);
+  { profile->millimeters = convert_delta_vector_to_unit_vector(unit_vec); }
+  profile->acceleration = limit_value_by_axis_maximum(settings.acceleration, unit_vec);
+  float rapid_rate = limit_value_by_axis_maximum(settings.max_rate, unit_vec);
+
+  #ifdef ENABLE_NATIVE_ARC_BLOCKS
+    if (block->condition & PL_COND_FLAG_ARC_MOTION) {
+      // Limit the arc speed by the centripetal acceleration, v^2/r, to the block acceleration. Applied
+      // to the rapid rate, which also caps feed rates and overrides of the block.
+      float max_arc_rate = sqrt(profile->acceleration*hypot_f(block->arc_offset[0], block->arc_offset[1]));
+      if (rapid_rate > max_arc_rate) { rapid_rate = max_arc_rate; }
+    }
+  #endif
+  #ifdef USE_COMPACT_PLANNER_BLOCKS
+    block->rapid_rate = plan_compact_rate(rapid_rate);
+  #else
+    block->rapid_rate = rapid_rate;
+  #endif
 
   // Store programmed rate.
-  if (block->condition & PL_COND_FLAG_RAPID_MOTION) { block->programmed_rate = block->rapid_rate; }
+  if (block->condition & PL_COND_FLAG_RAPID_MOTION) { block->programmed_rate = rapid_rate; }
   else {
     block->programmed_rate = pl_data->feed_rate;
-    if (block->condition & PL_COND_FLAG_INVERSE_TIME) { block->programmed_rate *= block->millimeters; }
+    if (block->condition & PL_COND_FLAG_INVERSE_TIME) { block->programmed_rate *= profile->millimeters; }
   }
 
+  #ifdef ENABLE_JERK_LIMITED_PROFILES
+    // The segment generator executes each ramp as an S-curve over the same time as the planned
+    // constant acceleration ramp, which peaks above the planned acceleration. Retain the axis-limited
+    // acceleration as the S-curve peak and plan with the average acceleration of a jerk-limited ramp
+    // from rest to the programmed rate: a = a_max*v/(v + a_max^2/j). A ramp of this size then exactly
+    // meets both the acceleration and jerk limits. A zero jerk setting disables the S-curve.
+    block->max_acceleration = profile->acceleration;
+    float jerk = limit_value_by_axis_maximum(settings.jerk, unit_vec);
+    if (jerk > 0.0) {
+      float ramp_rate = min(block->programmed_rate, rapid_rate);
+      profile->acceleration *= ramp_rate/(ramp_rate + profile->acceleration*profile->acceleration/jerk);
+    }
+  #endif
+
+  #ifdef ENABLE_NATIVE_ARC_BLOCKS
+    // Junction speeds of arc blocks are computed with the arc tangent at each end.
+    if (block->condition & PL_COND_FLAG_ARC_MOTION) { memcpy(unit_vec, arc_entry_unit_vec, sizeof(unit_vec)); }
+  #endif
+
   // TODO: Need to check this method handling zero junction speeds when starting from rest.
+  float max_junction_speed_sqr;
   if ((block_buffer_head == block_buffer_tail) || (block->condition & PL_COND_FLAG_SYSTEM_MOTION)) {
 
     // Initialize block entry speed as zero. Assume it will be starting from rest. Planner will correct this later.
     // If system motion, the system motion block always is assumed to start from rest and end at a complete stop.
-    block->entry_speed_sqr = 0.0;
-    block->max_junction_speed_sqr = 0.0; // Starting from rest. Enforce start from zero velocity.
+    profile->entry_speed_sqr = 0.0;
+    max_junction_speed_sqr = 0.0; // Starting from rest. Enforce start from zero velocity.
 
   } else {
     // Compute maximum allowable entry speed at junction by centripetal acceleration approximation.
@@ -405,28 +789,54 @@ uint8_t plan_buffer_line(float *target, plan_line_data_t *pl_data)
     // NOTE: Computed without any expensive trig, sin() or acos(), by trig half angle identity of cos(theta).
     if (junction_cos_theta > 0.999999) {
       //  For a 0 degree acute junction, just set minimum junction speed.
-      block->max_junction_speed_sqr = MINIMUM_JUNCTION_SPEED*MINIMUM_JUNCTION_SPEED;
+      max_junction_speed_sqr = MINIMUM_JUNCTION_SPEED*MINIMUM_JUNCTION_SPEED;
     } else {
       if (junction_cos_theta < -0.999999) {
         // Junction is a straight line or 180 degrees. Junction speed is infinite.
-        block->max_junction_speed_sqr = SOME_LARGE_VALUE;
+        max_junction_speed_sqr = SOME_LARGE_VALUE;
       } else {
-        convert_delta_vector_to_unit_vector(junction_unit_vec);
-        float junction_acceleration = limit_value_by_axis_maximum(settings.acceleration, junction_unit_vec);
-        float sin_theta_d2 = sqrt(0.5*(1.0-junction_cos_theta)); // Trig half angle identity. Always positive.
-        block->max_junction_speed_sqr = max( MINIMUM_JUNCTION_SPEED*MINIMUM_JUNCTION_SPEED,
-                       (junction_acceleration * settings.junction_deviation * sin_theta_d2)/(1.0-sin_theta_d2) );
+        #ifdef JUNCTION_FACTOR_TABLE_SIZE
+          // The junction vector length follows from the junction angle, |u-u_prev|^2 = 2*(1+cos(theta)),
+          // so it is scaled to a unit vector after the axis limits instead of normalizing it.
+          float junction_u = 1.0+junction_cos_theta;
+          float junction_acceleration = limit_value_by_axis_maximum(settings.acceleration, junction_unit_vec)*sqrt(2.0*junction_u);
+          max_junction_speed_sqr = max( MINIMUM_JUNCTION_SPEED*MINIMUM_JUNCTION_SPEED,
+                         junction_acceleration * settings.junction_deviation * plan_get_junction_factor(junction_u) );
+        #else
+          convert_delta_vector_to_unit_vector(junction_unit_vec);
+          float junction_acceleration = limit_value_by_axis_maximum(settings.acceleration, junction_unit_vec);
+          float sin_theta_d2 = sqrt(0.5*(1.0-junction_cos_theta)); // Trig half angle identity. Always positive.
+          max_junction_speed_sqr = max( MINIMUM_JUNCTION_SPEED*MINIMUM_JUNCTION_SPEED,
+                         (junction_acceleration * settings.junction_deviation * sin_theta_d2)/(1.0-sin_theta_d2) );
+        #endif
       }
     }
   }
+  #ifdef USE_COMPACT_PLANNER_BLOCKS
+    block->max_junction_speed = plan_compact_rate(sqrt(max_junction_speed_sqr));
+  #else
+    block->max_junction_speed_sqr = max_junction_speed_sqr;
+  #endif
 
   // Block system motion from updating this data to ensure next g-code motion is computed correctly.
   if (!(block->condition & PL_COND_FLAG_SYSTEM_MOTION)) {
+    #if defined(ENABLE_BLOCK_MERGING) || defined(ENABLE_PATH_BLENDING)
+      // Store the planner state prior to this block for merging or blending with the next motion.
+      memcpy(pl.merge_position, pl.position, sizeof(pl.position));
+      memcpy(pl.merge_unit_vec, pl.previous_unit_vec, sizeof(pl.previous_unit_vec));
+      pl.merge_nominal_speed = pl.previous_nominal_speed;
+    #endif
+    #ifdef ENABLE_BLOCK_MERGING
+      pl.merge_deviation = max(merge_deviation, 0.0);
+    #endif
     float nominal_speed = plan_compute_profile_nominal_speed(block);
-    plan_compute_profile_parameters(block, nominal_speed, pl.previous_nominal_speed);
+    plan_compute_profile_parameters(block_buffer_head, nominal_speed, pl.previous_nominal_speed);
     pl.previous_nominal_speed = nominal_speed;
 
     // Update previous path unit_vector and planner position.
+    #ifdef ENABLE_NATIVE_ARC_BLOCKS
+      if (block->condition & PL_COND_FLAG_ARC_MOTION) { memcpy(unit_vec, arc_exit_unit_vec, sizeof(unit_vec)); }
+    #endif
     memcpy(pl.previous_unit_vec, unit_vec, sizeof(unit_vec)); // pl.previous_unit_vec[] = unit_vec[]
     memcpy(pl.position, target_steps, sizeof(target_steps)); // pl.position[] = target_steps[]
 
@@ -441,6 +851,76 @@ uint8_t plan_buffer_line(float *target, plan_line_data_t *pl_data)
 }
 
 
+#ifdef ENABLE_PREPLANNED_BLOCKS
+  /* Add a new host-planned block to the buffer. The host supplies the block distance, acceleration
+     and rates, and its maximum, planned entry and planned exit speeds, such that the block unit vector
+     and junction speed computations are skipped. The lower of the maximum and planned entry speeds,
+     and of the planned exit speed of a preceding host-planned block, limits the block entry. The planner
+     passes then plan the buffered blocks as usual, to a stop at the end of the last one. So a feed hold
+     or a host underrun always stops within the buffered blocks. The unit vector is still tracked for the
+     junction of a following g-code motion.
+     NOTE: Assumes buffer is available and the block data is valid, as checked by motion_control. */
+  uint8_t plan_buffer_host_block(plan_host_block_t *host_block)
+  {
+    plan_block_t *block = &block_buffer[block_buffer_head];
+    plan_profile_t *profile = plan_block_profile(block_buffer_head);
+    memset(block,0,sizeof(plan_block_t)); // Zero all block values.
+    block->condition = (host_block->condition & PL_COND_FLAG_RAPID_MOTION) | PL_COND_FLAG_HOST_PLANNED;
+
+    uint8_t idx;
+    for (idx=0; idx<N_AXIS; idx++) {
+      block->steps[idx] = labs(host_block->steps[idx]);
+      block->step_event_count = max(block->step_event_count, block->steps[idx]);
+      if (host_block->steps[idx] < 0) { block->direction_bits |= get_direction_pin_mask(idx); }
+    }
+    if (block->step_event_count == 0) { return(PLAN_EMPTY_BLOCK); }
+
+    profile->millimeters = host_block->millimeters;
+    profile->acceleration = host_block->acceleration;
+    #ifdef ENABLE_JERK_LIMITED_PROFILES
+      block->max_acceleration = profile->acceleration;
+    #endif
+    if (block->condition & PL_COND_FLAG_RAPID_MOTION) { block->programmed_rate = host_block->rapid_rate; }
+    else { block->programmed_rate = host_block->programmed_rate; }
+    float max_junction_speed_sqr = min(host_block->max_entry_speed_sqr, host_block->entry_speed_sqr);
+    // The exit speed of a host-planned block only applies once this block follows it in the buffer.
+    if (block_buffer_head != block_buffer_tail) {
+      if (block_buffer[plan_prev_block_index(block_buffer_head)].condition & PL_COND_FLAG_HOST_PLANNED) {
+        max_junction_speed_sqr = min(max_junction_speed_sqr, pl.host_exit_speed_sqr);
+      }
+    }
+    pl.host_exit_speed_sqr = host_block->exit_speed_sqr;
+    #ifdef USE_COMPACT_PLANNER_BLOCKS
+      block->rapid_rate = plan_compact_rate(host_block->rapid_rate);
+      block->max_junction_speed = plan_compact_rate(sqrt(max_junction_speed_sqr));
+    #else
+      block->rapid_rate = host_block->rapid_rate;
+      block->max_junction_speed_sqr = max_junction_speed_sqr;
+    #endif
+
+    // NOTE: The condition flag prevents merging or blending a g-code motion with this block.
+    float nominal_speed = plan_compute_profile_nominal_speed(block);
+    plan_compute_profile_parameters(block_buffer_head, nominal_speed, pl.previous_nominal_speed);
+    pl.previous_nominal_speed = nominal_speed;
+
+    // Update previous path unit_vector and planner position.
+    float inv_millimeters = 1.0/profile->millimeters;
+    for (idx=0; idx<N_AXIS; idx++) {
+      pl.previous_unit_vec[idx] = (host_block->steps[idx]/settings.steps_per_mm[idx])*inv_millimeters;
+      pl.position[idx] += host_block->steps[idx];
+    }
+
+    // New block is all set. Update buffer head and next buffer head indices.
+    block_buffer_head = next_buffer_head;
+    next_buffer_head = plan_next_block_index(block_buffer_head);
+
+    // Finish up by recalculating the plan with the new block.
+    planner_recalculate();
+    return(PLAN_OK);
+  }
+#endif
+
+
 // Reset the planner position vectors. Called by the system abort/initialization routine.
 void plan_sync_position()
 {
@@ -453,6 +933,13 @@ void plan_sync_position()
 }
 
 
+// Returns the planner position of the tool in machine coordinates (mm).
+void plan_get_planner_mpos(float *target)
+{
+  system_convert_array_steps_to_mpos(target, pl.position);
+}
+
+
 // Returns the number of available blocks are in the planner buffer.
 uint8_t plan_get_block_buffer_available()
 {
@@ -474,6 +961,9 @@ uint8_t plan_get_block_buffer_count()
 // Called after a steppers have come to a complete stop for a feed hold and the cycle is stopped.
 void plan_cycle_reinitialize()
 {
+  #ifdef ENABLE_LAZY_OVERRIDE_REPLAN
+    if (pl.override_pending) { plan_update_velocity_profile_parameters(); }
+  #endif
   // Re-plan from a complete stop. Reset planner entry speeds and buffer planned pointer.
   st_update_plan_block_parameters();
   block_buffer_planned = block_buffer_tail;
@@ -25,13 +25,30 @@
 
 // The number of linear motions that can be in the plan at any give time
 #ifndef BLOCK_BUFFER_SIZE
-  #ifdef USE_LINE_NUMBERS
-    #define BLOCK_BUFFER_SIZE 15
+  #ifdef USE_COMPACT_PLANNER_BLOCKS
+    // Compact blocks fit more motions in the RAM of the default buffer.
+    #ifdef USE_LINE_NUMBERS
+      #define BLOCK_BUFFER_SIZE 19
+    #else
+      #define BLOCK_BUFFER_SIZE 21
+    #endif
   #else
-    #define BLOCK_BUFFER_SIZE 16
+    #ifdef USE_LINE_NUMBERS
+      #define BLOCK_BUFFER_SIZE 15
+    #else
+      #define BLOCK_BUFFER_SIZE 16
+    #endif
   #endif
 #endif
 
+#ifdef USE_COMPACT_PLANNER_BLOCKS
+  #define PLAN_MAX_BLOCK_STEPS 0xFFFF // Maximum axis step count of a compact block. Longer lines are split.
+  #define PLAN_MAX_BLOCK_RATE 0xFFFF  // Maximum rate limit of a compact block (mm/min)
+#elif defined(USE_FIXED_POINT_SEGMENT_PREP)
+  // Maximum axis step count, whose fixed-point step distance fits an int32. Longer lines are split.
+  #define PLAN_MAX_BLOCK_STEPS 0x7FFFFF
+#endif
+
 // Returned status message from planner.
 #define PLAN_OK true
 #define PLAN_EMPTY_BLOCK false
@@ -41,16 +58,38 @@
 #define PL_COND_FLAG_SYSTEM_MOTION     bit(1) // Single motion. Circumvents planner state. Used by home/park.
 #define PL_COND_FLAG_NO_FEED_OVERRIDE  bit(2) // Motion does not honor feed override.
 #define PL_COND_FLAG_INVERSE_TIME      bit(3) // Interprets feed rate value as inverse time when set.
+#define PL_COND_FLAG_ARC_MOTION        bit(4) // Native arc block. Only with ENABLE_NATIVE_ARC_BLOCKS.
+#define PL_COND_FLAG_HOST_PLANNED      bit(5) // Host-planned block. Only with ENABLE_PREPLANNED_BLOCKS.
+#define PL_COND_FLAG_STEP_TARGET       bit(6) // Target given in steps. Only with ENABLE_FIXED_POINT_COORDINATES.
 #define PL_COND_MOTION_MASK    (PL_COND_FLAG_RAPID_MOTION|PL_COND_FLAG_SYSTEM_MOTION|PL_COND_FLAG_NO_FEED_OVERRIDE)
 
 
+// This struct stores the velocity profile data of a planner block. These are the only fields used by
+// the planner passes in planner_recalculate(). Stored within the block data, or in a separate array at
+// the same buffer index with USE_SPLIT_PLANNER_PROFILES. Some of these values may be updated by the
+// stepper module during execution of special motion cases for replanning purposes.
+typedef struct {
+  float entry_speed_sqr;     // The current planned entry speed at block junction in (mm/min)^2
+  float max_entry_speed_sqr; // Maximum allowable entry speed based on the minimum of junction limit and
+                             //   neighboring nominal speeds with overrides in (mm/min)^2
+  float acceleration;        // Axis-limit adjusted line acceleration in (mm/min^2). Does not change.
+  float millimeters;         // The remaining distance for this block to be executed in (mm).
+                             // NOTE: This value may be altered by stepper algorithm during execution.
+} plan_profile_t;
+
+
 // This struct stores a linear movement of a g-code block motion with its critical "nominal" values
 // are as specified in the source g-code.
 typedef struct {
   // Fields used by the bresenham algorithm for tracing the line
   // NOTE: Used by stepper algorithm to execute the block correctly. Do not alter these values.
-  uint32_t steps[N_AXIS];    // Step count along each axis
-  uint32_t step_event_count; // The maximum step axis count and number of steps required to complete this block.
+  #ifdef USE_COMPACT_PLANNER_BLOCKS
+    uint16_t steps[N_AXIS];    // Step count along each axis. Arc end point of native arc blocks.
+    uint16_t step_event_count; // The maximum step axis count and number of steps required to complete this block.
+  #else
+    uint32_t steps[N_AXIS];    // Step count along each axis
+    uint32_t step_event_count; // The maximum step axis count and number of steps required to complete this block.
+  #endif
   uint8_t direction_bits;    // The direction bit set for this block (refers to *_DIRECTION_BIT in config.h)
 
   // Block condition data to ensure correct execution depending on states and overrides.
@@ -59,19 +98,33 @@ typedef struct {
     int32_t line_number;  // Block line number for real-time reporting. Copied from pl_line_data.
   #endif
 
-  // Fields used by the motion planner to manage acceleration. Some of these values may be updated
-  // by the stepper module during execution of special motion cases for replanning purposes.
-  float entry_speed_sqr;     // The current planned entry speed at block junction in (mm/min)^2
-  float max_entry_speed_sqr; // Maximum allowable entry speed based on the minimum of junction limit and
-                             //   neighboring nominal speeds with overrides in (mm/min)^2
-  float acceleration;        // Axis-limit adjusted line acceleration in (mm/min^2). Does not change.
-  float millimeters;         // The remaining distance for this block to be executed in (mm).
-                             // NOTE: This value may be altered by stepper algorithm during execution.
+  // Fields used by the motion planner to manage acceleration.
+  #ifndef USE_SPLIT_PLANNER_PROFILES
+    plan_profile_t profile;
+  #endif
+  #ifdef ENABLE_JERK_LIMITED_PROFILES
+    float max_acceleration;  // Axis-limit adjusted peak acceleration of S-curve ramps in (mm/min^2).
+  #endif
 
   // Stored rate limiting data used by planner when changes occur.
-  float max_junction_speed_sqr; // Junction entry speed limit based on direction vectors in (mm/min)^2
-  float rapid_rate;             // Axis-limit adjusted maximum rate for this block direction in (mm/min)
+  #ifdef USE_COMPACT_PLANNER_BLOCKS
+    // Rate limits are kept in whole mm/min, rounded down and capped at PLAN_MAX_BLOCK_RATE.
+    uint16_t max_junction_speed;  // Junction entry speed limit based on direction vectors in (mm/min)
+    uint16_t rapid_rate;          // Axis-limit adjusted maximum rate for this block direction in (mm/min)
+  #else
+    float max_junction_speed_sqr; // Junction entry speed limit based on direction vectors in (mm/min)^2
+    float rapid_rate;             // Axis-limit adjusted maximum rate for this block direction in (mm/min)
+  #endif
   float programmed_rate;        // Programmed rate of this block (mm/min).
+
+  #ifdef ENABLE_NATIVE_ARC_BLOCKS
+    // Arc geometry of native arc blocks. Axes outside of the arc plane, such as the helical axis, move
+    // linearly with the arc.
+    float arc_offset[2];       // Arc center offset from the block start position in the arc plane (mm)
+    float arc_angular_travel;  // Signed angular travel of the arc (radians). Counter-clockwise is positive.
+    uint8_t arc_axis_0;        // Arc plane axes. Arc offset indexing follows these.
+    uint8_t arc_axis_1;
+  #endif
 } plan_block_t;
 
 
@@ -82,9 +135,40 @@ typedef struct {
   #ifdef USE_LINE_NUMBERS
     int32_t line_number;    // Desired line number to report when executing.
   #endif
+  #ifdef ENABLE_PATH_BLENDING
+    float blend_tolerance;    // G64 corner blending tolerance (mm). Zero for exact path motions.
+  #endif
+  #ifdef ENABLE_NATIVE_ARC_BLOCKS
+    float arc_offset[2];      // Arc center offset from current position. Used with PL_COND_FLAG_ARC_MOTION.
+    float arc_angular_travel; // Signed arc angular travel (radians). Counter-clockwise is positive.
+    uint8_t arc_axis_0;       // Arc plane axes.
+    uint8_t arc_axis_1;
+  #endif
+  #ifdef ENABLE_FIXED_POINT_COORDINATES
+    int32_t target_steps[N_AXIS]; // Exact target in absolute steps. Used with PL_COND_FLAG_STEP_TARGET.
+  #endif
 } plan_line_data_t;
 
 
+#ifdef ENABLE_PREPLANNED_BLOCKS
+  // Host-planned block data prototype. Laid out as the frame data following CMD_PLANNED_BLOCK, which
+  // is read directly into it.
+  typedef struct {
+    int32_t steps[N_AXIS];     // Signed step count along each axis
+    float millimeters;         // Block distance (mm)
+    float acceleration;        // Block acceleration (mm/min^2)
+    float programmed_rate;     // Programmed rate (mm/min)
+    float rapid_rate;          // Maximum rate for this block direction (mm/min)
+    float max_entry_speed_sqr; // Junction entry speed limit (mm/min)^2
+    float entry_speed_sqr;     // Host-planned entry speed (mm/min)^2
+    float exit_speed_sqr;      // Host-planned exit speed (mm/min)^2
+    uint8_t condition;         // Block condition. Only PL_COND_FLAG_RAPID_MOTION is used.
+  } plan_host_block_t;
+  #define PLAN_HOST_BLOCK_SIZE (4*N_AXIS+4*7+1) // Frame data size. Excludes any struct padding.
+  #define PLAN_MAX_HOST_RATE 1.0E+9               // Upper limit of host-planned rates (mm/min)
+#endif
+
+
 // Initialize and reset the motion plan subsystem
 void plan_reset(); // Reset all
 void plan_reset_buffer(); // Reset buffer only.
@@ -94,6 +178,11 @@ void plan_reset_buffer(); // Reset buffer only.
 // rate is taken to mean "frequency" and would complete the operation in 1/feed_rate minutes.
 uint8_t plan_buffer_line(float *target, plan_line_data_t *pl_data);
 
+#ifdef ENABLE_PREPLANNED_BLOCKS
+  // Add a new host-planned block to the buffer. Skips the junction computations.
+  uint8_t plan_buffer_host_block(plan_host_block_t *host_block);
+#endif
+
 // Called when the current block is no longer needed. Discards the block and makes the memory
 // availible for new blocks.
 void plan_discard_current_block();
@@ -104,6 +193,9 @@ plan_block_t *plan_get_system_motion_block();
 // Gets the current block. Returns NULL if buffer empty
 plan_block_t *plan_get_current_block();
 
+// Gets the velocity profile data of a planner block.
+plan_profile_t *plan_get_block_profile(plan_block_t *block);
+
 // Called periodically by step segment buffer. Mostly used internally by planner.
 uint8_t plan_next_block_index(uint8_t block_index);
 
@@ -113,9 +205,23 @@ float plan_get_exec_block_exit_speed_sqr();
 // Called by main program during planner calculations and step segment buffer during initialization.
 float plan_compute_profile_nominal_speed(plan_block_t *block);
 
+// Computes the block nominal speed with the given override values. Used for slewing overrides.
+float plan_compute_profile_override_speed(plan_block_t *block, float f_override, float r_override);
+
 // Re-calculates buffered motions profile parameters upon a motion-based override change.
 void plan_update_velocity_profile_parameters();
 
+#ifdef ENABLE_LAZY_OVERRIDE_REPLAN
+  // Defers the re-plan upon a motion-based override change to the next block loaded by the stepper.
+  void plan_defer_velocity_profile_update();
+
+  // Returns true, if an override change has not yet been applied to the buffered blocks.
+  uint8_t plan_check_override_pending();
+
+  // Applies a deferred override change and re-plans the buffer from the given tail block entry speed.
+  void plan_apply_velocity_profile_update(float entry_speed);
+#endif
+
 // Reset the planner position vector (in steps)
 void plan_sync_position();
 
@@ -132,7 +238,17 @@ uint8_t plan_get_block_buffer_count();
 // Returns the status of the block ring buffer. True, if buffer is full.
 uint8_t plan_check_full_buffer();
 
+// Returns the planner position of the tool in machine coordinates (mm).
 void plan_get_planner_mpos(float *target);
 
+#ifdef ENABLE_PATH_BLENDING
+  // Checks if the last queued block may be replaced to blend its corner with a new line motion and
+  // returns its start position (mm) and, with line numbers, its line number in pl_data.
+  uint8_t plan_get_last_line_start(float *start, plan_line_data_t *pl_data);
+
+  // Removes the last queued block and restores the planner state prior to it.
+  void plan_remove_last_block();
+#endif
+
 
 #endif
@@ -29,9 +29,168 @@
 
 static char line[LINE_BUFFER_SIZE]; // Line to be executed. Zero-terminated.
 
+#ifdef ENABLE_SEGMENT_STREAMING
+  static uint8_t segment_streaming; // Flags streamed segment motion since the last text line.
+#endif
+
 static void protocol_exec_rt_suspend();
 
 
+#if defined(ENABLE_SEGMENT_STREAMING) || defined(ENABLE_PREPLANNED_BLOCKS) || defined(ENABLE_BINARY_PROTOCOL)
+  // Waits for and reads the data of a binary frame. It can't be read as a line, since any value is
+  // valid data. Returns false upon a system abort.
+  static uint8_t protocol_read_frame(uint8_t *data, uint8_t size)
+  {
+    while (serial_get_rx_buffer_count() < size) {
+      protocol_execute_realtime();
+      if (sys.abort) { return(false); }
+    }
+    uint8_t idx;
+    for (idx=0; idx<size; idx++) { data[idx] = serial_read(); }
+    return(true);
+  }
+#endif
+
+
+#ifdef ENABLE_SEGMENT_STREAMING
+  // Executes a streamed segment frame, starting with the given frame character. Block frames load
+  // the stepper block data and segment frames queue a segment directly in the segment buffer, which
+  // starts the motion. Any planned motion completes before the first frame is executed.
+  static uint8_t protocol_exec_segment_frame(uint8_t cmd)
+  {
+    uint8_t data[SEGMENT_BLOCK_FRAME_SIZE];
+    uint8_t size = SEGMENT_FRAME_SIZE;
+    if (cmd == CMD_SEGMENT_BLOCK) { size = SEGMENT_BLOCK_FRAME_SIZE; }
+    if (!protocol_read_frame(data, size)) { return(STATUS_OK); }
+
+    if (sys.state & (STATE_ALARM | STATE_JOG)) { return(STATUS_SYSTEM_GC_LOCK); }
+    if (sys.state == STATE_CHECK_MODE) { return(STATUS_OK); }
+
+    if (!segment_streaming) {
+      protocol_buffer_synchronize(); // Streamed segments can't be queued behind planned motion.
+      segment_streaming = true;
+    }
+    // Wait for room in the segment buffer and for any feed hold to be resumed.
+    while (st_check_full_segment_buffer() || (sys.state & STATE_HOLD)) {
+      protocol_execute_realtime();
+      if (sys.abort) { return(STATUS_OK); }
+    }
+
+    // Frame data is little-endian, as is the AVR.
+    if (cmd == CMD_SEGMENT_BLOCK) {
+      uint32_t steps[N_AXIS];
+      memcpy(steps, &data[1], sizeof(steps));
+      st_stream_block(steps, data[0]);
+    } else {
+      uint16_t n_step;
+      uint32_t cycles;
+      memcpy(&n_step, &data[0], sizeof(n_step));
+      memcpy(&cycles, &data[2], sizeof(cycles));
+      if (!st_stream_segment(n_step, cycles)) { return(STATUS_SEGMENT_INVALID); }
+      // Start the motion, or restart it after a segment buffer underrun. A cycle stop flagged before
+      // the segment was queued is executed first, since the stepper has gone idle without it.
+      protocol_execute_realtime();
+      if (sys.abort) { return(STATUS_OK); }
+      if (sys.state == STATE_IDLE) {
+        sys.state = STATE_CYCLE;
+        st_wake_up();
+      }
+    }
+    return(STATUS_OK);
+  }
+
+
+  // Ends streamed segment motion. Waits for it to complete and syncs the g-code and planner
+  // positions to the machine position, as after a jog cancel.
+  static void protocol_end_segment_stream()
+  {
+    protocol_buffer_synchronize();
+    gc_sync_position();
+    plan_sync_position();
+    segment_streaming = false;
+  }
+#endif
+
+
+#ifdef ENABLE_PREPLANNED_BLOCKS
+  // Executes a host-planned block frame, which queues the block in the planner buffer, as a g-code
+  // motion would. The frame data is little-endian, as is the AVR, and is read directly into the
+  // unpadded block data struct.
+  static uint8_t protocol_exec_planned_block_frame()
+  {
+    plan_host_block_t host_block;
+    if (!protocol_read_frame((uint8_t*)&host_block, PLANNED_BLOCK_FRAME_SIZE)) { return(STATUS_OK); }
+
+    if (sys.state & (STATE_ALARM | STATE_JOG)) { return(STATUS_SYSTEM_GC_LOCK); }
+    #ifdef ENABLE_SEGMENT_STREAMING
+      if (segment_streaming) {
+        protocol_end_segment_stream();
+        if (sys.abort) { return(STATUS_OK); }
+      }
+    #endif
+    uint8_t status_code = mc_host_block(&host_block);
+    // Keep the g-code position at the end of the queued motion for any following g-code motion.
+    if ((status_code == STATUS_OK) && (sys.state != STATE_CHECK_MODE)) {
+      plan_get_planner_mpos(gc_state.position);
+      #ifdef ENABLE_FIXED_POINT_COORDINATES
+        gc_sync_position_fixed();
+      #endif
+    }
+    return(status_code);
+  }
+#endif
+
+
+#ifdef ENABLE_MAIN_LOOP_TELEMETRY
+  // Executes a g-code line and records its execution time. Time spent in realtime execution, which
+  // includes waiting for room in the planner buffer, is not counted.
+  static uint8_t protocol_exec_timed_gcode_line(char *line)
+  {
+    uint32_t line_start = system_get_telemetry_time();
+    uint32_t realtime_start = sys_telemetry.realtime_time;
+    uint8_t status_code = gc_execute_line(line);
+    uint32_t line_time = system_get_telemetry_elapsed(line_start)-(sys_telemetry.realtime_time-realtime_start);
+    if (line_time & ~TELEMETRY_TIME_MASK) { line_time = 0; } // Timer wrapped around during a long wait.
+    if (line_time > sys_telemetry.max_line_time) { sys_telemetry.max_line_time = line_time; }
+    sys_telemetry.line_time += line_time;
+    sys_telemetry.line_count++;
+    return(status_code);
+  }
+#endif
+
+
+#ifdef ENABLE_BINARY_PROTOCOL
+  // Executes a binary motion block frame as a g-code line. The frame is read into its own buffer,
+  // since it may arrive while a text line is received.
+  static uint8_t protocol_exec_binary_block_frame()
+  {
+    char block[GC_BINARY_BLOCK_SIZE];
+    block[0] = CMD_BINARY_BLOCK;
+    if (!protocol_read_frame((uint8_t*)&block[1], GC_BINARY_HEADER_SIZE)) { return(STATUS_OK); }
+    uint8_t size = 0;
+    uint8_t word_mask = block[2];
+    for (; word_mask; word_mask >>= 1) {
+      if (word_mask & 1) { size += sizeof(float); }
+    }
+    if (!protocol_read_frame((uint8_t*)&block[1+GC_BINARY_HEADER_SIZE], size)) { return(STATUS_OK); }
+
+    #ifdef ENABLE_SEGMENT_STREAMING
+      if (segment_streaming) {
+        protocol_end_segment_stream();
+        if (sys.abort) { return(STATUS_OK); }
+      }
+    #endif
+    // Block if in alarm or jog mode, as any g-code line.
+    if (sys.state & (STATE_ALARM | STATE_JOG)) { return(STATUS_SYSTEM_GC_LOCK); }
+    #ifdef ENABLE_MAIN_LOOP_TELEMETRY
+      return(protocol_exec_timed_gcode_line(block));
+    #else
+      return(gc_execute_line(block));
+    #endif
+  }
+#endif
+
+
 /*
   GRBL PRIMARY LOOP:
 */
@@ -57,15 +216,51 @@ void protocol_main_loop()
   uint8_t line_flags = 0;
   uint8_t char_counter = 0;
   uint8_t c;
+  #ifdef ENABLE_SEGMENT_STREAMING
+    segment_streaming = false;
+  #endif
   for (;;) {
 
     // Process one line of incoming serial data, as the data becomes available. Performs an
     // initial filtering by removing spaces and comments and capitalizing all letters.
     while((c = serial_read()) != SERIAL_NO_DATA) {
+      #ifdef ENABLE_SEGMENT_STREAMING
+        if ((c == CMD_SEGMENT_BLOCK) || (c == CMD_SEGMENT)) {
+          report_status_message(protocol_exec_segment_frame(c));
+          if (sys.abort) { return; } // Bail to calling function upon system abort
+          continue;
+        }
+      #endif
+      #ifdef ENABLE_BINARY_PROTOCOL
+        if (c == CMD_BINARY_BLOCK) {
+          report_status_message(protocol_exec_binary_block_frame());
+          if (sys.abort) { return; } // Bail to calling function upon system abort
+          continue;
+        }
+      #endif
+      #ifdef ENABLE_PREPLANNED_BLOCKS
+        if (c == CMD_PLANNED_BLOCK) {
+          report_status_message(protocol_exec_planned_block_frame());
+          if (sys.abort) { return; } // Bail to calling function upon system abort
+          continue;
+        }
+      #endif
       if ((c == '\n') || (c == '\r')) { // End of line reached
 
         protocol_execute_realtime(); // Runtime command check point.
         if (sys.abort) { return; } // Bail to calling function upon system abort
+        #ifdef ENABLE_PARSE_AHEAD_QUEUE
+          mc_execute_queue(); // Refill the planner buffer from the parsed line motions.
+        #endif
+        #ifdef ENABLE_INCREMENTAL_ARCS
+          mc_execute_arc(); // Resume the arc, if the planner buffer has room.
+        #endif
+        #ifdef ENABLE_SEGMENT_STREAMING
+          if (segment_streaming) {
+            protocol_end_segment_stream();
+            if (sys.abort) { return; }
+          }
+        #endif
 
         line[char_counter] = 0; // Set string termination character.
         #ifdef REPORT_ECHO_LINE_RECEIVED
@@ -87,7 +282,11 @@ void protocol_main_loop()
           report_status_message(STATUS_SYSTEM_GC_LOCK);
         } else {
           // Parse and execute g-code block.
-          report_status_message(gc_execute_line(line));
+          #ifdef ENABLE_MAIN_LOOP_TELEMETRY
+            report_status_message(protocol_exec_timed_gcode_line(line));
+          #else
+            report_status_message(gc_execute_line(line));
+          #endif
         }
 
         // Reset tracking data for next line.
@@ -144,6 +343,12 @@ void protocol_main_loop()
 
     protocol_execute_realtime();  // Runtime command check point.
     if (sys.abort) { return; } // Bail to main() program loop to reset system.
+    #ifdef ENABLE_PARSE_AHEAD_QUEUE
+      mc_execute_queue(); // Refill the planner buffer from the parsed line motions.
+    #endif
+    #ifdef ENABLE_INCREMENTAL_ARCS
+      mc_execute_arc(); // Resume the arc, if the planner buffer has room.
+    #endif
   }
 
   return; /* Never reached */
@@ -156,10 +361,21 @@ void protocol_buffer_synchronize()
 {
   // If system is queued, ensure cycle resumes if the auto start flag is present.
   protocol_auto_cycle_start();
+  #ifdef ENABLE_INCREMENTAL_ARCS
+    mc_finish_arc(); // Remaining arc segments are part of the buffered motions.
+  #endif
+  uint8_t is_buffered;
   do {
     protocol_execute_realtime();   // Check and execute run-time commands
     if (sys.abort) { return; } // Check for system abort
-  } while (plan_get_current_block() || (sys.state == STATE_CYCLE));
+    #ifdef ENABLE_PARSE_AHEAD_QUEUE
+      mc_execute_queue(); // Queued line motions are part of the buffered motions.
+      is_buffered = mc_check_queue();
+    #else
+      is_buffered = false;
+    #endif
+    if (plan_get_current_block() || (sys.state == STATE_CYCLE)) { is_buffered = true; }
+  } while (is_buffered);
 }
 
 
@@ -190,8 +406,31 @@ void protocol_auto_cycle_start()
 // limit switches, or the main program.
 void protocol_execute_realtime()
 {
+  #ifdef ENABLE_MAIN_LOOP_TELEMETRY
+    uint32_t realtime_start = system_get_telemetry_time();
+  #endif
   protocol_exec_rt_system();
   if (sys.suspend) { protocol_exec_rt_suspend(); }
+  #ifdef ENABLE_MAIN_LOOP_TELEMETRY
+    sys_telemetry.realtime_time += system_get_telemetry_elapsed(realtime_start);
+  #endif
+}
+
+
+// Applies new feed and rapid override values and re-plans the buffered motions accordingly.
+static void protocol_exec_motion_overrides(uint8_t new_f_override, uint8_t new_r_override)
+{
+  if ((new_f_override != sys.f_override) || (new_r_override != sys.r_override)) {
+    sys.f_override = new_f_override;
+    sys.r_override = new_r_override;
+    sys.report_ovr_counter = 0; // Set to report change immediately
+    #ifdef ENABLE_LAZY_OVERRIDE_REPLAN
+      plan_defer_velocity_profile_update();
+    #else
+      plan_update_velocity_profile_parameters();
+      plan_cycle_reinitialize();
+    #endif
+  }
 }
 
 
@@ -311,6 +550,12 @@ void protocol_exec_rt_system()
         if (sys.suspend & SUSPEND_JOG_CANCEL) {   // For jog cancel, flush buffers and sync positions.
           sys.step_control = STEP_CONTROL_NORMAL_OP;
           plan_reset();
+          #ifdef ENABLE_PARSE_AHEAD_QUEUE
+            mc_reset_queue();
+          #endif
+          #ifdef ENABLE_INCREMENTAL_ARCS
+            mc_reset_arc();
+          #endif
           st_reset();
           gc_sync_position();
           plan_sync_position();
@@ -341,15 +586,29 @@ void protocol_exec_rt_system()
     if (rt_exec & EXEC_RAPID_OVR_MEDIUM) { new_r_override = RAPID_OVERRIDE_MEDIUM; }
     if (rt_exec & EXEC_RAPID_OVR_LOW) { new_r_override = RAPID_OVERRIDE_LOW; }
 
-    if ((new_f_override != sys.f_override) || (new_r_override != sys.r_override)) {
-      sys.f_override = new_f_override;
-      sys.r_override = new_r_override;
-      sys.report_ovr_counter = 0; // Set to report change immediately
-      plan_update_velocity_profile_parameters();
-      plan_cycle_reinitialize();
-    }
+    protocol_exec_motion_overrides(new_f_override, new_r_override);
   }
 
+  #ifdef ENABLE_CONTINUOUS_OVERRIDES
+    // Execute continuous overrides. Values are limited to the same range as the override steps.
+    if (sys_rt_f_override_value || sys_rt_r_override_value) {
+      uint8_t new_f_override = sys.f_override;
+      uint8_t new_r_override = sys.r_override;
+      uint8_t sreg = SREG;
+      cli();
+      if (sys_rt_f_override_value) { new_f_override = sys_rt_f_override_value; }
+      if (sys_rt_r_override_value) { new_r_override = sys_rt_r_override_value; }
+      sys_rt_f_override_value = 0;
+      sys_rt_r_override_value = 0;
+      SREG = sreg;
+      new_f_override = min(new_f_override,MAX_FEED_RATE_OVERRIDE);
+      new_f_override = max(new_f_override,MIN_FEED_RATE_OVERRIDE);
+      new_r_override = min(new_r_override,DEFAULT_RAPID_OVERRIDE);
+      new_r_override = max(new_r_override,RAPID_OVERRIDE_LOW);
+      protocol_exec_motion_overrides(new_f_override, new_r_override);
+    }
+  #endif
+
   #ifdef DEBUG
     if (sys_rt_exec_debug) {
       report_realtime_debug();
@@ -32,6 +32,15 @@
   #define LINE_BUFFER_SIZE 80
 #endif
 
+#ifdef ENABLE_SEGMENT_STREAMING
+  // Data sizes of the streamed segment frames following the CMD_SEGMENT_BLOCK and CMD_SEGMENT characters.
+  #define SEGMENT_BLOCK_FRAME_SIZE (1+4*N_AXIS) // Direction mask and step counts
+  #define SEGMENT_FRAME_SIZE 6                  // Step events and cycles per step event
+#endif
+#ifdef ENABLE_PREPLANNED_BLOCKS
+  #define PLANNED_BLOCK_FRAME_SIZE PLAN_HOST_BLOCK_SIZE // Data size following CMD_PLANNED_BLOCK
+#endif
+
 // Starts Grbl main loop. It handles all incoming characters from the serial port and executes
 // them as they complete. It is also responsible for finishing the initialization procedures.
 void protocol_main_loop();
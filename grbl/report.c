@@ -59,6 +59,7 @@ static void report_util_setting_string(uint8_t n) {
     case 10: printPgmString(PSTR("rpt")); break;
     case 11: printPgmString(PSTR("jnc dev")); break;
     case 12: printPgmString(PSTR("arc tol")); break;
+    case 14: printPgmString(PSTR("ovr slew")); break;
     case 20: printPgmString(PSTR("sft lim")); break;
     case 21: printPgmString(PSTR("hrd lim")); break;
     case 22: printPgmString(PSTR("hm cyc")); break;
@@ -80,6 +81,7 @@ static void report_util_setting_string(uint8_t n) {
         case 1: printPgmString(PSTR(":mm/min")); break;
         case 2: printPgmString(PSTR(":mm/s^2")); break;
         case 3: printPgmString(PSTR(":mm max")); break;
+        case 4: printPgmString(PSTR(":mm/s^3")); break;
       }
       break;
   }
@@ -180,6 +182,9 @@ void report_grbl_settings() {
   report_util_uint8_setting(10,settings.status_report_mask);
   report_util_float_setting(11,settings.junction_deviation,N_DECIMAL_SETTINGVALUE);
   report_util_float_setting(12,settings.arc_tolerance,N_DECIMAL_SETTINGVALUE);
+  #ifdef ENABLE_CONTINUOUS_OVERRIDES
+    report_util_float_setting(14,settings.override_slew_rate,N_DECIMAL_SETTINGVALUE);
+  #endif
   report_util_uint8_setting(32,0);
   // Print axis settings
   uint8_t idx, set_idx;
@@ -191,6 +196,9 @@ void report_grbl_settings() {
         case 1: report_util_float_setting(val+idx,settings.max_rate[idx],N_DECIMAL_SETTINGVALUE); break;
         case 2: report_util_float_setting(val+idx,settings.acceleration[idx]/(60*60),N_DECIMAL_SETTINGVALUE); break;
         case 3: report_util_float_setting(val+idx,-settings.max_travel[idx],N_DECIMAL_SETTINGVALUE); break;
+        #ifdef ENABLE_JERK_LIMITED_PROFILES
+          case 4: report_util_float_setting(val+idx,settings.jerk[idx]/(60*60*60),N_DECIMAL_SETTINGVALUE); break;
+        #endif
       }
     }
     val += AXIS_SETTINGS_INCREMENT;
@@ -242,6 +250,12 @@ void report_gcode_modes()
   report_util_gcode_modes_G();
   print_uint8_base10(94-gc_state.modal.feed_rate);
 
+  #ifdef ENABLE_PATH_BLENDING
+    report_util_gcode_modes_G();
+    if (gc_state.modal.control == CONTROL_MODE_BLEND) { print_uint8_base10(64); }
+    else { print_uint8_base10(61); }
+  #endif
+
   if (gc_state.modal.program_flow) {
     report_util_gcode_modes_M();
     switch (gc_state.modal.program_flow) {
@@ -312,6 +326,75 @@ void report_build_info(char *line)
   #ifdef ENABLE_DUAL_AXIS
     serial_write('2');
   #endif
+  #ifdef ENABLE_JERK_LIMITED_PROFILES
+    serial_write('J');
+  #endif
+  #ifdef ENABLE_NATIVE_ARC_BLOCKS
+    serial_write('B');
+  #endif
+  #ifdef ENABLE_PATH_BLENDING
+    serial_write('G');
+  #endif
+  #ifdef ENABLE_CONTINUOUS_OVERRIDES
+    serial_write('O');
+  #endif
+  #ifdef ENABLE_SEGMENT_STREAMING
+    serial_write('F');
+  #endif
+  #ifdef ENABLE_PREPLANNED_BLOCKS
+    serial_write('U');
+  #endif
+  #ifdef ENABLE_BINARY_PROTOCOL
+    serial_write('Q');
+  #endif
+  #ifdef ENABLE_LINEAR_FAST_PATH
+    serial_write('K');
+  #endif
+  #ifdef ENABLE_FIXED_POINT_COORDINATES
+    serial_write('X');
+  #endif
+  #ifdef ENABLE_PARSE_AHEAD_QUEUE
+    serial_write('Y');
+  #endif
+  #ifdef ENABLE_INCREMENTAL_ARCS
+    serial_write('3');
+  #endif
+  #ifdef ENABLE_ADAPTIVE_ARC_SEGMENTS
+    serial_write('4');
+  #endif
+  #ifdef ENABLE_STEPPER_ISR_PROFILE
+    serial_write('5');
+  #endif
+  #ifdef ENABLE_MAIN_LOOP_TELEMETRY
+    serial_write('6');
+  #endif
+  #ifdef USE_SEGMENT_POSITION_COUNTERS
+    serial_write('7');
+  #endif
+  #ifdef ENABLE_STEP_BURST
+    serial_write('8');
+  #endif
+  #ifdef ENABLE_BLOCK_MERGING
+    serial_write('m');
+  #endif
+  #ifdef USE_COMPACT_PLANNER_BLOCKS
+    serial_write('c');
+  #endif
+  #ifdef ENABLE_LAZY_OVERRIDE_REPLAN
+    serial_write('l');
+  #endif
+  #ifdef USE_FIXED_POINT_SEGMENT_PREP
+    serial_write('p');
+  #endif
+  #ifdef ENABLE_CRUISE_SEGMENT_CACHE
+    serial_write('s');
+  #endif
+  #ifdef USE_SPLIT_PLANNER_PROFILES
+    serial_write('a');
+  #endif
+  #ifdef JUNCTION_FACTOR_TABLE_SIZE
+    serial_write('j');
+  #endif
   // NOTE: Compiled values, like override increments/max/min values, may be added at some point later.
   serial_write(',');
   print_uint8_base10(BLOCK_BUFFER_SIZE-1);
@@ -340,7 +423,11 @@ void report_realtime_status()
 {
   uint8_t idx;
   int32_t current_position[N_AXIS]; // Copy current state of the system position variable
-  memcpy(current_position,sys_position,sizeof(sys_position));
+  #ifdef USE_SEGMENT_POSITION_COUNTERS
+    st_get_position(current_position);
+  #else
+    memcpy(current_position,sys_position,sizeof(sys_position));
+  #endif
   float print_position[N_AXIS];
   system_convert_array_steps_to_mpos(print_position,current_position);
 
@@ -430,6 +517,64 @@ void report_realtime_status()
 }
 
 
+#ifdef ENABLE_STEPPER_ISR_PROFILE
+  // Prints the stepper driver interrupt profile in the form '[ISR:min,avg,max,count,overruns,reentries]'.
+  // Times are in microseconds.
+  void report_isr_profile()
+  {
+    st_isr_profile_t profile;
+    st_get_isr_profile(&profile);
+    float usec_per_tick = 8.0/TICKS_PER_MICROSECOND;
+    printPgmString(PSTR("[ISR:"));
+    if (profile.count) {
+      printFloat(profile.min*usec_per_tick,1);
+      serial_write(',');
+      printFloat(profile.sum*usec_per_tick/profile.count,1);
+      serial_write(',');
+      printFloat(profile.max*usec_per_tick,1);
+    } else {
+      printPgmString(PSTR("0.0,0.0,0.0"));
+    }
+    serial_write(',');
+    print_uint32_base10(profile.count);
+    serial_write(',');
+    print_uint32_base10(profile.overruns);
+    serial_write(',');
+    print_uint32_base10(profile.reentries);
+    report_util_feedback_line_feed();
+  }
+#endif
+
+
+#ifdef ENABLE_MAIN_LOOP_TELEMETRY
+  // Prints the main loop telemetry in the form '[TLM:latency,line max,line avg,lines,starvations,low water]'.
+  // Times are in microseconds.
+  void report_telemetry()
+  {
+    sys_telemetry_t telemetry;
+    uint8_t sreg = SREG;
+    cli(); // The stepper interrupt counts starvations.
+    memcpy(&telemetry, &sys_telemetry, sizeof(sys_telemetry_t));
+    SREG = sreg;
+    float usec_per_tick = (float)TELEMETRY_PRESCALER/TICKS_PER_MICROSECOND;
+    printPgmString(PSTR("[TLM:"));
+    print_uint32_base10(telemetry.max_latency*usec_per_tick);
+    serial_write(',');
+    print_uint32_base10(telemetry.max_line_time*usec_per_tick);
+    serial_write(',');
+    if (telemetry.line_count) { print_uint32_base10(telemetry.line_time*usec_per_tick/telemetry.line_count); }
+    else { serial_write('0'); }
+    serial_write(',');
+    print_uint32_base10(telemetry.line_count);
+    serial_write(',');
+    print_uint32_base10(telemetry.starvations);
+    serial_write(',');
+    print_uint8_base10(telemetry.planner_low_water);
+    report_util_feedback_line_feed();
+  }
+#endif
+
+
 #ifdef DEBUG
   void report_realtime_debug()
   {
@@ -55,6 +55,8 @@
 #define STATUS_GCODE_UNUSED_WORDS 36
 #define STATUS_GCODE_G43_DYNAMIC_AXIS_ERROR 37
 #define STATUS_GCODE_MAX_VALUE_EXCEEDED 38
+#define STATUS_SEGMENT_INVALID 39
+#define STATUS_PLANNED_BLOCK_INVALID 40
 
 // Define Grbl alarm codes. Valid values (1-255). 0 is reserved.
 #define ALARM_ABORT_CYCLE           EXEC_ALARM_ABORT_CYCLE
@@ -106,6 +108,16 @@ void report_execute_startup_message(char *line, uint8_t status_code);
 // Prints build info and user info
 void report_build_info(char *line);
 
+#ifdef ENABLE_STEPPER_ISR_PROFILE
+  // Prints the stepper driver interrupt profile
+  void report_isr_profile();
+#endif
+
+#ifdef ENABLE_MAIN_LOOP_TELEMETRY
+  // Prints the main loop telemetry
+  void report_telemetry();
+#endif
+
 #ifdef DEBUG
   void report_realtime_debug();
 #endif
@@ -145,6 +145,81 @@ ISR(SERIAL_RX)
   uint8_t data = UDR0;
   uint8_t next_head;
 
+  #ifdef ENABLE_CONTINUOUS_OVERRIDES
+    // The byte following a continuous override command is its value. Zero is stored as one, since it
+    // flags no pending value, and either is limited to the minimum override.
+    static uint8_t override_cmd = 0;
+    if (override_cmd) {
+      if (data == 0) { data = 1; }
+      if (override_cmd == CMD_FEED_OVR_SET) { sys_rt_f_override_value = data; }
+      else { sys_rt_r_override_value = data; }
+      override_cmd = 0;
+      return;
+    }
+  #endif
+
+  #if defined(ENABLE_SEGMENT_STREAMING) || defined(ENABLE_PREPLANNED_BLOCKS) || defined(ENABLE_BINARY_PROTOCOL)
+    // Write the binary data of a streamed segment, planned block or binary motion block frame to the
+    // buffer without picking off realtime command characters. The frame characters are written as well,
+    // so the main program can locate the frames in the stream. Only a reset is recognized within a
+    // frame, such that a host that stopped mid-frame can still recover. Data bytes equal to CMD_RESET
+    // or CMD_FRAME_ESCAPE are sent escaped by a preceding CMD_FRAME_ESCAPE.
+    static uint8_t frame_count = 0;
+    static uint8_t frame_escape = false; // Flags an escaped data byte.
+    #ifdef ENABLE_BINARY_PROTOCOL
+      static uint8_t frame_word_mask = false; // Flags the word mask byte of a binary motion block.
+    #endif
+    if (frame_count) {
+      if (frame_escape) { frame_escape = false; }
+      else if (data == CMD_FRAME_ESCAPE) {
+        frame_escape = true;
+        return;
+      } else if (data == CMD_RESET) {
+        // Drop the partial frame. The main program clears the serial read buffer upon the reset.
+        frame_count = 0;
+        #ifdef ENABLE_BINARY_PROTOCOL
+          frame_word_mask = false;
+        #endif
+        mc_reset();
+        return;
+      }
+    } else { // Frame character counts itself.
+      #ifdef ENABLE_SEGMENT_STREAMING
+        if (data == CMD_SEGMENT_BLOCK) { frame_count = SEGMENT_BLOCK_FRAME_SIZE+1; }
+        else if (data == CMD_SEGMENT) { frame_count = SEGMENT_FRAME_SIZE+1; }
+      #endif
+      #ifdef ENABLE_PREPLANNED_BLOCKS
+        if (data == CMD_PLANNED_BLOCK) { frame_count = PLANNED_BLOCK_FRAME_SIZE+1; }
+      #endif
+      #ifdef ENABLE_BINARY_PROTOCOL
+        if (data == CMD_BINARY_BLOCK) {
+          frame_count = GC_BINARY_HEADER_SIZE+1;
+          frame_word_mask = true;
+        }
+      #endif
+    }
+    if (frame_count) {
+      frame_count--;
+      #ifdef ENABLE_BINARY_PROTOCOL
+        // The word mask ends the header. Each word set in it is followed by a float value.
+        if (frame_word_mask && !frame_count) {
+          uint8_t word_mask = data;
+          for (; word_mask; word_mask >>= 1) {
+            if (word_mask & 1) { frame_count += sizeof(float); }
+          }
+          frame_word_mask = false;
+        }
+      #endif
+      next_head = serial_rx_buffer_head + 1;
+      if (next_head == RX_RING_BUFFER) { next_head = 0; }
+      if (next_head != serial_rx_buffer_tail) {
+        serial_rx_buffer[serial_rx_buffer_head] = data;
+        serial_rx_buffer_head = next_head;
+      }
+      return;
+    }
+  #endif
+
   // Pick off realtime command characters directly from the serial stream. These characters are
   // not passed into the main buffer, but these set system state flag bits for realtime execution.
   switch (data) {
@@ -171,6 +246,9 @@ ISR(SERIAL_RX)
           case CMD_RAPID_OVR_RESET: system_set_exec_motion_override_flag(EXEC_RAPID_OVR_RESET); break;
           case CMD_RAPID_OVR_MEDIUM: system_set_exec_motion_override_flag(EXEC_RAPID_OVR_MEDIUM); break;
           case CMD_RAPID_OVR_LOW: system_set_exec_motion_override_flag(EXEC_RAPID_OVR_LOW); break;
+          #ifdef ENABLE_CONTINUOUS_OVERRIDES
+            case CMD_FEED_OVR_SET: case CMD_RAPID_OVR_SET: override_cmd = data; break;
+          #endif
         }
         // Throw away any unfound extended-ASCII character by not passing it to the serial buffer.
       } else { // Write character to buffer
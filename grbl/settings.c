@@ -31,26 +31,81 @@ const __flash settings_t defaults = {\
     .status_report_mask = DEFAULT_STATUS_REPORT_MASK,
     .junction_deviation = DEFAULT_JUNCTION_DEVIATION,
     .arc_tolerance = DEFAULT_ARC_TOLERANCE,
+    #ifdef ENABLE_CONTINUOUS_OVERRIDES
+      .override_slew_rate = DEFAULT_OVERRIDE_SLEW_RATE,
+    #endif
     .flags = (DEFAULT_INVERT_ST_ENABLE << BIT_INVERT_ST_ENABLE),
     .steps_per_mm[X_AXIS] = DEFAULT_X_STEPS_PER_MM,
     .steps_per_mm[Y_AXIS] = DEFAULT_Y_STEPS_PER_MM,
     #ifdef Z_AXIS
       .steps_per_mm[Z_AXIS] = DEFAULT_Z_STEPS_PER_MM,
     #endif
+    #ifdef A_AXIS
+      .steps_per_mm[A_AXIS] = DEFAULT_A_STEPS_PER_MM,
+    #endif
+    #ifdef B_AXIS
+      .steps_per_mm[B_AXIS] = DEFAULT_B_STEPS_PER_MM,
+    #endif
+    #ifdef C_AXIS
+      .steps_per_mm[C_AXIS] = DEFAULT_C_STEPS_PER_MM,
+    #endif
     .max_rate[X_AXIS] = DEFAULT_X_MAX_RATE,
     .max_rate[Y_AXIS] = DEFAULT_Y_MAX_RATE,
     #ifdef Z_AXIS
       .max_rate[Z_AXIS] = DEFAULT_Z_MAX_RATE,
     #endif
+    #ifdef A_AXIS
+      .max_rate[A_AXIS] = DEFAULT_A_MAX_RATE,
+    #endif
+    #ifdef B_AXIS
+      .max_rate[B_AXIS] = DEFAULT_B_MAX_RATE,
+    #endif
+    #ifdef C_AXIS
+      .max_rate[C_AXIS] = DEFAULT_C_MAX_RATE,
+    #endif
     .acceleration[X_AXIS] = DEFAULT_X_ACCELERATION,
     .acceleration[Y_AXIS] = DEFAULT_Y_ACCELERATION,
     #ifdef Z_AXIS
       .acceleration[Z_AXIS] = DEFAULT_Z_ACCELERATION,
     #endif
+    #ifdef A_AXIS
+      .acceleration[A_AXIS] = DEFAULT_A_ACCELERATION,
+    #endif
+    #ifdef B_AXIS
+      .acceleration[B_AXIS] = DEFAULT_B_ACCELERATION,
+    #endif
+    #ifdef C_AXIS
+      .acceleration[C_AXIS] = DEFAULT_C_ACCELERATION,
+    #endif
     .max_travel[X_AXIS] = (-DEFAULT_X_MAX_TRAVEL),
     .max_travel[Y_AXIS] = (-DEFAULT_Y_MAX_TRAVEL),
     #ifdef Z_AXIS
-      .max_travel[Z_AXIS] = (-DEFAULT_Z_MAX_TRAVEL)
+      .max_travel[Z_AXIS] = (-DEFAULT_Z_MAX_TRAVEL),
+    #endif
+    #ifdef A_AXIS
+      .max_travel[A_AXIS] = (-DEFAULT_A_MAX_TRAVEL),
+    #endif
+    #ifdef B_AXIS
+      .max_travel[B_AXIS] = (-DEFAULT_B_MAX_TRAVEL),
+    #endif
+    #ifdef C_AXIS
+      .max_travel[C_AXIS] = (-DEFAULT_C_MAX_TRAVEL),
+    #endif
+    #ifdef ENABLE_JERK_LIMITED_PROFILES
+      .jerk[X_AXIS] = DEFAULT_X_JERK,
+      .jerk[Y_AXIS] = DEFAULT_Y_JERK,
+      #ifdef Z_AXIS
+        .jerk[Z_AXIS] = DEFAULT_Z_JERK,
+      #endif
+      #ifdef A_AXIS
+        .jerk[A_AXIS] = DEFAULT_A_JERK,
+      #endif
+      #ifdef B_AXIS
+        .jerk[B_AXIS] = DEFAULT_B_JERK,
+      #endif
+      #ifdef C_AXIS
+        .jerk[C_AXIS] = DEFAULT_C_JERK,
+      #endif
     #endif
     };
 
@@ -210,6 +265,9 @@ uint8_t settings_store_global_setting(uint8_t parameter, float value) {
             break;
           case 2: settings.acceleration[parameter] = value*60*60; break; // Convert to mm/min^2 for grbl internal use.
           case 3: settings.max_travel[parameter] = -value; break;  // Store as negative for grbl internal use.
+          #ifdef ENABLE_JERK_LIMITED_PROFILES
+            case 4: settings.jerk[parameter] = value*60*60*60; break; // Convert to mm/min^3 for grbl internal use.
+          #endif
         }
         break; // Exit while-loop after setting has been configured and proceed to the EEPROM write call.
       } else {
@@ -242,6 +300,9 @@ uint8_t settings_store_global_setting(uint8_t parameter, float value) {
       case 10: settings.status_report_mask = int_value; break;
       case 11: settings.junction_deviation = value; break;
       case 12: settings.arc_tolerance = value; break;
+      #ifdef ENABLE_CONTINUOUS_OVERRIDES
+        case 14: settings.override_slew_rate = value; break;
+      #endif
       default:
         return(STATUS_INVALID_STATEMENT);
     }
@@ -261,14 +322,15 @@ void settings_init() {
 }
 
 
+// Axis table expansions returning the step or direction pin mask of an axis index.
+#define AXIS_STEP_PIN_CASE(axis,step_bit,direction_bit) case axis: return((1<<(step_bit)));
+#define AXIS_DIRECTION_PIN_CASE(axis,step_bit,direction_bit) case axis: return((1<<(direction_bit)));
+
+
 // Returns step pin mask according to Grbl internal axis indexing.
 uint8_t get_step_pin_mask(uint8_t axis_idx)
 {
-  if ( axis_idx == X_AXIS ) { return((1<<X_STEP_BIT)); }
-  if ( axis_idx == Y_AXIS ) { return((1<<Y_STEP_BIT)); }
-  #ifdef Z_AXIS
-    return((1<<Z_STEP_BIT));
-  #endif
+  switch (axis_idx) { AXIS_TABLE(AXIS_STEP_PIN_CASE) }
   return 0;
 }
 
@@ -276,10 +338,6 @@ uint8_t get_step_pin_mask(uint8_t axis_idx)
 // Returns direction pin mask according to Grbl internal axis indexing.
 uint8_t get_direction_pin_mask(uint8_t axis_idx)
 {
-  if ( axis_idx == X_AXIS ) { return((1<<X_DIRECTION_BIT)); }
-  if ( axis_idx == Y_AXIS ) { return((1<<Y_DIRECTION_BIT)); }
-  #ifdef Z_AXIS
-    return((1<<Z_DIRECTION_BIT));
-  #endif
+  switch (axis_idx) { AXIS_TABLE(AXIS_DIRECTION_PIN_CASE) }
   return 0;
 }
\ No newline at end of file
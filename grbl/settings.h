@@ -63,7 +63,11 @@
 // #define SETTING_INDEX_G92    N_COORDINATE_SYSTEM+2  // Coordinate offset (G92.2,G92.3 not supported)
 
 // Define Grbl axis settings numbering scheme. Starts at START_VAL, every INCREMENT, over N_SETTINGS.
-#define AXIS_N_SETTINGS          4
+#ifdef ENABLE_JERK_LIMITED_PROFILES
+  #define AXIS_N_SETTINGS        5
+#else
+  #define AXIS_N_SETTINGS        4
+#endif
 #define AXIS_SETTINGS_START_VAL  100 // NOTE: Reserving settings values >= 100 for axis settings. Up to 255.
 #define AXIS_SETTINGS_INCREMENT  10  // Must be greater than the number of axis settings
 
@@ -74,6 +78,9 @@ typedef struct {
   float max_rate[N_AXIS];
   float acceleration[N_AXIS];
   float max_travel[N_AXIS];
+  #ifdef ENABLE_JERK_LIMITED_PROFILES
+    float jerk[N_AXIS];
+  #endif
 
   // Remaining Grbl settings
   uint8_t pulse_microseconds;
@@ -83,6 +90,9 @@ typedef struct {
   uint8_t status_report_mask; // Mask to indicate desired report data.
   float junction_deviation;
   float arc_tolerance;
+  #ifdef ENABLE_CONTINUOUS_OVERRIDES
+    float override_slew_rate;
+  #endif
 
   uint8_t flags;  // Contains default boolean settings
 } settings_t;
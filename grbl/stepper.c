@@ -24,16 +24,35 @@
 
 // Some useful constants.
 #define DT_SEGMENT (1.0/(ACCELERATION_TICKS_PER_SECOND*60.0)) // min/segment
+#ifdef CRUISE_SEGMENT_TIME_MULTIPLIER
+  #define DT_SEGMENT_CRUISE (CRUISE_SEGMENT_TIME_MULTIPLIER*DT_SEGMENT) // min/segment
+#endif
+#ifdef RAMP_SEGMENT_TIME_DIVISOR
+  #define DT_SEGMENT_RAMP (DT_SEGMENT/RAMP_SEGMENT_TIME_DIVISOR) // min/segment
+#endif
 #define REQ_MM_INCREMENT_SCALAR 1.25
 #define RAMP_ACCEL 0
 #define RAMP_CRUISE 1
 #define RAMP_DECEL 2
 #define RAMP_DECEL_OVERRIDE 3
 
+#ifdef USE_FIXED_POINT_SEGMENT_PREP
+  #define STEP_DIST_FRACT_BITS 8 // Fractional bits of fixed-point step distances
+  #define STEP_DIST_SCALAR (1L << STEP_DIST_FRACT_BITS)
+  #define CYCLES_PER_MINUTE (TICKS_PER_MICROSECOND*1000000*60)
+#endif
+
 #define PREP_FLAG_RECALCULATE bit(0)
 #define PREP_FLAG_HOLD_PARTIAL_BLOCK bit(1)
 #define PREP_FLAG_DECEL_OVERRIDE bit(3)
 
+#ifdef ENABLE_SEGMENT_STREAMING
+  // Define the states of the stepper block data of streamed segments.
+  #define STREAM_BLOCK_NONE 0   // Stepper block index is not of a streamed block.
+  #define STREAM_BLOCK_EMPTY 1  // Streamed block loaded. No segments of it queued yet.
+  #define STREAM_BLOCK_ACTIVE 2 // Streamed block with segments queued.
+#endif
+
 // Define Adaptive Multi-Axis Step-Smoothing(AMASS) levels and cutoff frequencies. The highest level
 // frequency bin starts at 0Hz and ends at its cutoff frequency. The next lower level frequency bin
 // starts at the next higher cutoff frequency, and so on. The cutoff frequencies for each level must
@@ -55,6 +74,20 @@
   #endif
 #endif
 
+// Step burst cutoff frequencies. Above each, the stepper ISR executes more step events per tick, which
+// keeps the ISR frequency at or below STEP_BURST_FREQUENCY up to four times that step frequency. Below
+// level 1, one step event per tick. Bursts are shortened when their pulse train would not fit the tick.
+// NOTE: A burst tick is at most twice the level 1 cutoff period, which must remain in AMASS level 0.
+#ifdef ENABLE_STEP_BURST
+  #define STEP_BURST_MAX_STEPS 4 // Maximum step events per ISR tick
+  #define STEP_BURST_LEVEL1 (F_CPU/STEP_BURST_FREQUENCY) // Bursts of 2 steps. Defined as F_CPU/(Cutoff frequency in Hz)
+  #define STEP_BURST_LEVEL2 (F_CPU/STEP_BURST_FREQUENCY/2) // Bursts of 4 steps
+
+  #if defined(ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING) && (STEP_BURST_FREQUENCY <= 16000)
+    #error "STEP_BURST_FREQUENCY must be greater than twice the AMASS level 1 cutoff frequency."
+  #endif
+#endif
+
 
 // Stores the planner block Bresenham algorithm execution data for the segments in the segment
 // buffer. Normally, this buffer is partially in-use, but, for the worst case scenario, it will
@@ -85,15 +118,16 @@ typedef struct {
   #else
     uint8_t prescaler;      // Without AMASS, a prescaler is required to adjust for slow timing.
   #endif
+  #ifdef ENABLE_STEP_BURST
+    uint8_t burst_steps;    // Step events per ISR tick after the first. Zero when not bursting.
+  #endif
 } segment_t;
 static segment_t segment_buffer[SEGMENT_BUFFER_SIZE];
 
 // Stepper ISR data struct. Contains the running data for the main stepper ISR.
 typedef struct {
   // Used by the bresenham line algorithm
-  uint32_t counter_x,        // Counter variables for the bresenham line tracer
-           counter_y,
-           counter_z;
+  uint32_t counter[N_AXIS]; // Counter variables for the bresenham line tracer
   #ifdef STEP_PULSE_DELAY
     uint8_t step_bits;  // Stores out_bits output to complete the step pulse delay
   #endif
@@ -109,6 +143,13 @@ typedef struct {
   #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
     uint32_t steps[N_AXIS];
   #endif
+  #ifdef USE_SEGMENT_POSITION_COUNTERS
+    uint16_t segment_steps[N_AXIS]; // Steps executed in the segment, not yet in sys_position[]
+  #endif
+  #ifdef ENABLE_STEP_BURST
+    uint8_t burst_outbits[STEP_BURST_MAX_STEPS]; // Stepping-bits of each step event of the next tick
+    uint8_t burst_steps;       // Step pulses of the next tick after the first
+  #endif
 
   uint16_t step_count;       // Steps remaining in line segment motion
   uint8_t exec_block_index; // Tracks the current st_block index. Change indicates new block.
@@ -133,9 +174,14 @@ static uint8_t dir_port_invert_mask;
 // Used to avoid ISR nesting of the "Stepper Driver Interrupt". Should never occur though.
 static volatile uint8_t busy;
 
+#ifdef ENABLE_STEPPER_ISR_PROFILE
+  static st_isr_profile_t isr_profile; // Updated by the stepper driver interrupt only.
+#endif
+
 // Pointers for the step segment being prepped from the planner buffer. Accessed only by the
 // main program. Pointers may be planning segments or planner blocks ahead of what being executed.
 static plan_block_t *pl_block;     // Pointer to the planner block being prepped
+static plan_profile_t *pl_profile; // Pointer to the velocity profile data of the prepped planner block
 static st_block_t *st_prep_block;  // Pointer to the stepper block data being prepped
 
 // Segment preparation data struct. Contains all the necessary information to compute new segments
@@ -144,8 +190,13 @@ typedef struct {
   uint8_t st_block_index;  // Index of stepper common data block being prepped
   uint8_t recalculate_flag;
 
-  float dt_remainder;
-  float steps_remaining;
+  #ifdef USE_FIXED_POINT_SEGMENT_PREP
+    int32_t dt_remainder;    // Execution time of the partial step of the previous segment (CPU cycles)
+    int32_t steps_remaining; // Whole steps remaining in the block
+  #else
+    float dt_remainder;
+    float steps_remaining;
+  #endif
   float step_per_mm;
   float req_mm_increment;
 
@@ -158,6 +209,40 @@ typedef struct {
   float accelerate_until; // Acceleration ramp end measured from end of block (mm)
   float decelerate_after; // Deceleration ramp start measured from end of block (mm)
 
+  #ifdef ENABLE_JERK_LIMITED_PROFILES
+    float ramp_mm;          // Start of the active S-curve ramp measured from end of block (mm)
+    float ramp_speed;       // Speed at the start of the active S-curve ramp (mm/min)
+    float ramp_delta_speed; // Signed speed change over the active S-curve ramp (mm/min)
+    float ramp_time;        // Total execution time of the active S-curve ramp (min)
+    float ramp_jerk_time;   // Execution time of each jerk phase of the active S-curve ramp (min)
+    float ramp_elapsed;     // Executed time of the active S-curve ramp (min)
+  #endif
+
+  #ifdef ENABLE_CRUISE_SEGMENT_CACHE
+    uint8_t cruise_cache;     // Consecutive full cruise segments computed. Cache is valid when 2.
+    float cruise_mm;          // Distance of a full cruise segment (mm)
+    segment_t cruise_segment; // Step timing of full cruise segments
+    #ifdef USE_FIXED_POINT_SEGMENT_PREP
+      uint32_t cruise_cycles; // CPU cycles per step of full cruise segments
+    #else
+      float cruise_inv_rate;  // Inverse step rate of full cruise segments (min/step)
+    #endif
+  #endif
+
+  #ifdef ENABLE_NATIVE_ARC_BLOCKS
+    float arc_millimeters;     // Total path length of the prepped arc block (mm)
+    float arc_segment_mm;      // Maximum segment length within the arc tolerance (mm)
+    int32_t arc_steps[N_AXIS]; // Signed steps prepped from the start of the arc block
+  #endif
+
+  #ifdef ENABLE_SEGMENT_STREAMING
+    uint8_t stream_block;      // State of the stepper block data of streamed segments
+  #endif
+
+  #ifdef ENABLE_CONTINUOUS_OVERRIDES
+    float f_override; // Executed feed override, slewing to the commanded value (percent)
+    float r_override; // Executed rapid override, slewing to the commanded value (percent)
+  #endif
 } st_prep_t;
 static st_prep_t prep;
 
@@ -198,9 +283,30 @@ static st_prep_t prep;
   The step segment buffer computes the executing block velocity profile and tracks the critical
   parameters for the stepper algorithm to accurately trace the profile. These critical parameters
   are shown and defined in the above illustration.
+
+  With jerk-limited profiles enabled, the acceleration and deceleration ramps keep the same start
+  and end points, but the speed follows an S-curve in between. The acceleration rises linearly to
+  its peak, holds, and falls linearly back to zero, symmetric about the middle of the ramp, such that
+  the ramp takes exactly the same time and distance as the planned constant acceleration ramp.
 */
 
 
+#ifdef USE_SEGMENT_POSITION_COUNTERS
+  // Adds the step counts of the executing segment to the machine position. Called by the stepper
+  // interrupt when the segment completes and when the steppers go idle.
+  static void st_update_position()
+  {
+    if (st.exec_block == NULL) { return; } // No segment executed since reset.
+    uint8_t idx;
+    for (idx=0; idx<N_AXIS; idx++) {
+      if (st.exec_block->direction_bits & get_direction_pin_mask(idx)) { sys_position[idx] -= st.segment_steps[idx]; }
+      else { sys_position[idx] += st.segment_steps[idx]; }
+      st.segment_steps[idx] = 0;
+    }
+  }
+#endif
+
+
 // Stepper state initialization. Cycle should only start if the st.cycle_start flag is
 // enabled. Startup init calls this function but shouldn't start the cycle.
 void st_wake_up()
@@ -211,6 +317,9 @@ void st_wake_up()
 
   // Initialize stepper output bits to ensure first ISR call does not step.
   st.step_outbits = step_port_invert_mask;
+  #ifdef ENABLE_STEP_BURST
+    st.burst_steps = 0;
+  #endif
 
   // Initialize step pulse timing from settings. Here to ensure updating after re-writing.
   #ifdef STEP_PULSE_DELAY
@@ -235,6 +344,9 @@ void st_go_idle()
   TIMSK1 &= ~(1<<OCIE1A); // Disable Timer1 interrupt
   TCCR1B = (TCCR1B & ~((1<<CS12) | (1<<CS11))) | (1<<CS10); // Reset clock to no prescaling.
   busy = false;
+  #ifdef USE_SEGMENT_POSITION_COUNTERS
+    st_update_position(); // Steps of a segment stopped by a reset.
+  #endif
 
   // Set stepper driver idle state, disabled or enabled, depending on settings and circumstances.
   bool pin_state = false; // Keep enabled.
@@ -250,6 +362,39 @@ void st_go_idle()
 }
 
 
+// Axis table expansions of the per-axis stepper code. Each expands with a constant axis index, so
+// the counter and step array elements are at fixed addresses, like separate per-axis variables.
+#define ST_AXIS_INIT_COUNTER(axis,step_bit,direction_bit) \
+  st.counter[axis] = (st.exec_block->step_event_count >> 1);
+#define ST_AXIS_AMASS_STEPS(axis,step_bit,direction_bit) \
+  st.steps[axis] = st.exec_block->steps[axis] >> st.exec_segment->amass_level;
+#ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+  #define ST_AXIS_INCREMENT(axis) st.steps[axis]
+#else
+  #define ST_AXIS_INCREMENT(axis) st.exec_block->steps[axis]
+#endif
+#ifdef ENABLE_DUAL_AXIS
+  #define ST_AXIS_DUAL_STEP(axis) if ((axis) == DUAL_AXIS_SELECT) { st.step_outbits_dual = (1<<DUAL_STEP_BIT); }
+#else
+  #define ST_AXIS_DUAL_STEP(axis)
+#endif
+#ifdef USE_SEGMENT_POSITION_COUNTERS
+  #define ST_AXIS_POSITION_STEP(axis,direction_bit) st.segment_steps[axis]++;
+#else
+  #define ST_AXIS_POSITION_STEP(axis,direction_bit) \
+    if (st.exec_block->direction_bits & (1<<(direction_bit))) { sys_position[axis]--; } \
+    else { sys_position[axis]++; }
+#endif
+#define ST_AXIS_STEP(axis,step_bit,direction_bit) \
+  st.counter[axis] += ST_AXIS_INCREMENT(axis); \
+  if (st.counter[axis] > st.exec_block->step_event_count) { \
+    st.step_outbits |= (1<<(step_bit)); \
+    ST_AXIS_DUAL_STEP(axis) \
+    st.counter[axis] -= st.exec_block->step_event_count; \
+    ST_AXIS_POSITION_STEP(axis,direction_bit) \
+  }
+
+
 /* "The Stepper Driver Interrupt" - This timer interrupt is the workhorse of Grbl. Grbl employs
    the venerable Bresenham line algorithm to manage and exactly synchronize multi-axis moves.
    Unlike the popular DDA algorithm, the Bresenham algorithm is not susceptible to numerical
@@ -298,9 +443,19 @@ void st_go_idle()
 // TODO: Replace direct updating of the int32 position counters in the ISR somehow. Perhaps use smaller
 // int8 variables and update position counters only when a segment completes. This can get complicated
 // with probing and homing cycles that require true real-time positions.
+// NOTE: Done by USE_SEGMENT_POSITION_COUNTERS, since this build has no probing or homing cycles.
 ISR(TIMER1_COMPA_vect)
 {
-  if (busy) { return; } // The busy-flag is used to avoid reentering this interrupt
+  #ifdef ENABLE_STEPPER_ISR_PROFILE
+    uint8_t isr_start = TCNT2; // Timestamp as early as possible.
+  #endif
+  if (busy) { // The busy-flag is used to avoid reentering this interrupt
+    #ifdef ENABLE_STEPPER_ISR_PROFILE
+      if (isr_profile.overruns != 0xffff) { isr_profile.overruns++; } // Saturate, rather than wrap.
+      if (isr_profile.reentries != 0xffff) { isr_profile.reentries++; }
+    #endif
+    return;
+  }
 
   // Set the direction pins a couple of nanoseconds before we step the steppers
   DIRECTION_PORT = (DIRECTION_PORT & ~DIRECTION_MASK) | (st.dir_outbits & DIRECTION_MASK);
@@ -330,6 +485,19 @@ ISR(TIMER1_COMPA_vect)
   sei(); // Re-enable interrupts to allow Stepper Port Reset Interrupt to fire on-time.
          // NOTE: The remaining code in this ISR will finish before returning to main program.
 
+  #ifdef ENABLE_STEP_BURST
+    // Output the other step pulses of a burst as a pulse train. Each begins once the Stepper Port
+    // Reset Interrupt has ended the previous pulse and the pins have been low for the low time.
+    uint8_t burst_idx;
+    for (burst_idx = 1; burst_idx <= st.burst_steps; burst_idx++) {
+      while (TCCR0B) {} // Wait for the step pulse reset.
+      _delay_us(STEP_BURST_LOW_TIME);
+      STEP_PORT = (STEP_PORT & ~STEP_MASK) | st.burst_outbits[burst_idx];
+      TCNT0 = st.step_pulse_time;
+      TCCR0B = (1<<CS01);
+    }
+  #endif
+
   // If there is no step segment, attempt to pop one from the stepper buffer
   if (st.exec_segment == NULL) {
     // Anything in the buffer? If so, load and initialize next step segment.
@@ -352,7 +520,7 @@ ISR(TIMER1_COMPA_vect)
         st.exec_block = &st_block_buffer[st.exec_block_index];
 
         // Initialize Bresenham line and distance counters
-        st.counter_x = st.counter_y = st.counter_z = (st.exec_block->step_event_count >> 1);
+        AXIS_TABLE(ST_AXIS_INIT_COUNTER)
       }
       st.dir_outbits = st.exec_block->direction_bits ^ dir_port_invert_mask;
       #ifdef ENABLE_DUAL_AXIS
@@ -361,21 +529,29 @@ ISR(TIMER1_COMPA_vect)
 
       #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
         // With AMASS enabled, adjust Bresenham axis increment counters according to AMASS level.
-        st.steps[X_AXIS] = st.exec_block->steps[X_AXIS] >> st.exec_segment->amass_level;
-        st.steps[Y_AXIS] = st.exec_block->steps[Y_AXIS] >> st.exec_segment->amass_level;
-        #ifdef Z_AXIS
-          st.steps[Z_AXIS] = st.exec_block->steps[Z_AXIS] >> st.exec_segment->amass_level;
-        #endif
+        AXIS_TABLE(ST_AXIS_AMASS_STEPS)
       #endif
 
     } else {
       // Segment buffer empty. Shutdown.
+      #ifdef ENABLE_MAIN_LOOP_TELEMETRY
+        // Planner blocks left in a cycle mean the segment buffer was not refilled in time.
+        if ((sys.state == STATE_CYCLE) && (plan_get_current_block() != NULL)) { sys_telemetry.starvations++; }
+      #endif
       st_go_idle();
       system_set_exec_state_flag(EXEC_CYCLE_STOP); // Flag main program for cycle end
       return; // Nothing to do but exit.
     }
   }
 
+  #ifdef ENABLE_STEP_BURST
+    // Execute all step events of the next tick, unless the segment completes first. The first is
+    // output on the next ISR entry and the others by its pulse train.
+    uint8_t burst_steps = st.exec_segment->burst_steps;
+    st.burst_steps = 0;
+    for (;;) {
+  #endif
+
   // Reset step out bits.
   st.step_outbits = 0;
   #ifdef ENABLE_DUAL_AXIS
@@ -383,51 +559,14 @@ ISR(TIMER1_COMPA_vect)
   #endif
 
   // Execute step displacement profile by Bresenham line algorithm
-  #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
-    st.counter_x += st.steps[X_AXIS];
-  #else
-    st.counter_x += st.exec_block->steps[X_AXIS];
-  #endif
-  if (st.counter_x > st.exec_block->step_event_count) {
-    st.step_outbits |= (1<<X_STEP_BIT);
-    #if defined(ENABLE_DUAL_AXIS) && (DUAL_AXIS_SELECT == X_AXIS)
-      st.step_outbits_dual = (1<<DUAL_STEP_BIT);
-    #endif
-    st.counter_x -= st.exec_block->step_event_count;
-    if (st.exec_block->direction_bits & (1<<X_DIRECTION_BIT)) { sys_position[X_AXIS]--; }
-    else { sys_position[X_AXIS]++; }
-  }
-  #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
-    st.counter_y += st.steps[Y_AXIS];
-  #else
-    st.counter_y += st.exec_block->steps[Y_AXIS];
-  #endif
-  if (st.counter_y > st.exec_block->step_event_count) {
-    st.step_outbits |= (1<<Y_STEP_BIT);
-    #if defined(ENABLE_DUAL_AXIS) && (DUAL_AXIS_SELECT == Y_AXIS)
-      st.step_outbits_dual = (1<<DUAL_STEP_BIT);
-    #endif
-    st.counter_y -= st.exec_block->step_event_count;
-    if (st.exec_block->direction_bits & (1<<Y_DIRECTION_BIT)) { sys_position[Y_AXIS]--; }
-    else { sys_position[Y_AXIS]++; }
-  }
-  #ifdef Z_AXIS
-    #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
-      st.counter_z += st.steps[Z_AXIS];
-    #else
-      st.counter_z += st.exec_block->steps[Z_AXIS];
-    #endif
-    if (st.counter_z > st.exec_block->step_event_count) {
-      st.step_outbits |= (1<<Z_STEP_BIT);
-      st.counter_z -= st.exec_block->step_event_count;
-      if (st.exec_block->direction_bits & (1<<Z_DIRECTION_BIT)) { sys_position[Z_AXIS]--; }
-      else { sys_position[Z_AXIS]++; }
-    }
-  #endif
+  AXIS_TABLE(ST_AXIS_STEP)
 
   st.step_count--; // Decrement step events count
   if (st.step_count == 0) {
     // Segment is complete. Discard current segment and advance segment indexing.
+    #ifdef USE_SEGMENT_POSITION_COUNTERS
+      st_update_position();
+    #endif
     st.exec_segment = NULL;
     if ( ++segment_buffer_tail == SEGMENT_BUFFER_SIZE) { segment_buffer_tail = 0; }
   }
@@ -436,6 +575,29 @@ ISR(TIMER1_COMPA_vect)
   #ifdef ENABLE_DUAL_AXIS
     st.step_outbits_dual ^= step_port_invert_mask_dual;
   #endif
+
+  #ifdef ENABLE_STEP_BURST
+      st.burst_outbits[st.burst_steps] = st.step_outbits;
+      if ((st.exec_segment == NULL) || (st.burst_steps == burst_steps)) { break; }
+      st.burst_steps++;
+    }
+    st.step_outbits = st.burst_outbits[0];
+  #endif
+
+  #ifdef ENABLE_STEPPER_ISR_PROFILE
+    cli(); // Keep the profile consistent for st_get_isr_profile(). Re-enabled on return.
+    uint8_t isr_ticks = TCNT2-isr_start;
+    // The compare flag is set again if the next interrupt is due. A re-entry has already cleared it.
+    if ((TIFR1 & (1<<OCF1A)) && (isr_profile.overruns != 0xffff)) { isr_profile.overruns++; }
+    // Stop averaging before the sum overflows. The count cannot overflow first, since every profiled
+    // interrupt takes several ticks.
+    if (isr_profile.sum <= (0xffffffff-0xff)) {
+      isr_profile.count++;
+      isr_profile.sum += isr_ticks;
+    }
+    if (isr_ticks < isr_profile.min) { isr_profile.min = isr_ticks; }
+    if (isr_ticks > isr_profile.max) { isr_profile.max = isr_ticks; }
+  #endif
   busy = false;
 }
 
@@ -505,6 +667,10 @@ void st_reset()
   // Initialize stepper algorithm variables.
   memset(&prep, 0, sizeof(st_prep_t));
   memset(&st, 0, sizeof(stepper_t));
+  #ifdef ENABLE_CONTINUOUS_OVERRIDES
+    prep.f_override = sys.f_override;
+    prep.r_override = sys.r_override;
+  #endif
   st.exec_segment = NULL;
   pl_block = NULL;  // Planner block pointer used by segment buffer
   segment_buffer_tail = 0;
@@ -556,6 +722,14 @@ void stepper_init()
   #ifdef STEP_PULSE_DELAY
     TIMSK0 |= (1<<OCIE0A); // Enable Timer0 Compare Match A interrupt
   #endif
+
+  #ifdef ENABLE_STEPPER_ISR_PROFILE
+    // Configure Timer 2: Free-running stepper driver interrupt profiling timer
+    TIMSK2 = 0; // No interrupts
+    TCCR2A = 0; // Normal operation
+    TCCR2B = (1<<CS21); // 1/8 prescaler
+    st_reset_isr_profile();
+  #endif
 }
 
 
@@ -564,12 +738,161 @@ void st_update_plan_block_parameters()
 {
   if (pl_block != NULL) { // Ignore if at start of a new block.
     prep.recalculate_flag |= PREP_FLAG_RECALCULATE;
-    pl_block->entry_speed_sqr = prep.current_speed*prep.current_speed; // Update entry speed.
+    pl_profile->entry_speed_sqr = prep.current_speed*prep.current_speed; // Update entry speed.
     pl_block = NULL; // Flag st_prep_segment() to load and check active velocity profile.
   }
 }
 
 
+#ifdef ENABLE_JERK_LIMITED_PROFILES
+  // Starts an S-curve ramp from the current speed to the target speed at mm_start from the end of
+  // the block. The ramp time is that of the planned constant acceleration ramp. The acceleration is
+  // shaped as a trapezoid in time, where the jerk phases are stretched as far as the peak acceleration
+  // allows, up to a triangle. With no jerk limit, the peak is the planned acceleration and the jerk
+  // phases vanish, leaving the standard trapezoidal velocity profile.
+  // NOTE: The ramp is shortened to end by mm_end, when the planned ramp is longer than the distance
+  // left. This happens, when a re-plan leaves a block with an exit speed it can't accelerate to, as
+  // after a deferred override change, where the trapezoidal profile jumps to the ramp end speed instead.
+  static void st_ramp_init(float mm_start, float mm_end, float target_speed)
+  {
+    prep.ramp_mm = mm_start;
+    prep.ramp_speed = prep.current_speed;
+    prep.ramp_delta_speed = target_speed-prep.current_speed;
+    float delta_speed = fabs(prep.ramp_delta_speed);
+    prep.ramp_time = delta_speed/pl_profile->acceleration;
+    float max_ramp_time = 2.0*(mm_start-mm_end)/(prep.current_speed+target_speed);
+    if (!(max_ramp_time > 0.0)) { prep.ramp_time = 0.0; } // No distance left or both speeds zero.
+    else if (prep.ramp_time > max_ramp_time) { prep.ramp_time = max_ramp_time; }
+    prep.ramp_jerk_time = prep.ramp_time - delta_speed/pl_block->max_acceleration;
+    if (prep.ramp_jerk_time < 0.0) { prep.ramp_jerk_time = 0.0; }
+    else if (prep.ramp_jerk_time > 0.5*prep.ramp_time) { prep.ramp_jerk_time = 0.5*prep.ramp_time; }
+    prep.ramp_elapsed = 0.0;
+  }
+
+
+  // Advances the active S-curve ramp by time_var. Returns true, if the ramp ends within time_var,
+  // which is then trimmed to the remaining ramp time. The caller sets the ramp end speed and distance.
+  // Otherwise, updates the current speed and the distance from the end of the block. The ramp also
+  // ends, if float round-off carries it past mm_end, the end of the ramp distance.
+  static uint8_t st_ramp_advance(float *time_var, float *mm_remaining, float mm_end)
+  {
+    float t = prep.ramp_elapsed + *time_var;
+    if (t >= prep.ramp_time) {
+      *time_var = prep.ramp_time-prep.ramp_elapsed;
+      return(true);
+    }
+
+    // Compute the speed change fraction and its time integral for a unit speed change. The second
+    // half of the ramp mirrors the first half about the middle of the ramp.
+    float u = t;
+    if (t > 0.5*prep.ramp_time) { u = prep.ramp_time-t; }
+    float peak_accel = 1.0/(prep.ramp_time-prep.ramp_jerk_time);
+    float fraction, integral;
+    if (u < prep.ramp_jerk_time) { // Rising acceleration
+      fraction = peak_accel*u*u/(2.0*prep.ramp_jerk_time);
+      integral = fraction*u*(1.0/3.0);
+    } else { // Constant acceleration
+      float u_mid = u - 0.5*prep.ramp_jerk_time;
+      fraction = peak_accel*u_mid;
+      integral = peak_accel*(0.5*u_mid*u_mid + prep.ramp_jerk_time*prep.ramp_jerk_time*(1.0/24.0));
+    }
+    if (u != t) {
+      fraction = 1.0-fraction;
+      integral += t-0.5*prep.ramp_time;
+    }
+    float mm_var = prep.ramp_mm - (prep.ramp_speed*t + prep.ramp_delta_speed*integral);
+    if (mm_var < mm_end) {
+      *time_var = prep.ramp_time-prep.ramp_elapsed;
+      return(true);
+    }
+    prep.ramp_elapsed = t;
+    prep.current_speed = prep.ramp_speed + prep.ramp_delta_speed*fraction;
+    *mm_remaining = mm_var;
+    return(false);
+  }
+#endif
+
+
+#ifdef USE_FIXED_POINT_SEGMENT_PREP
+  // Converts a distance from the end of the block to a fixed-point step distance. Rounded up, such that
+  // rounding it up to whole steps matches the float version exactly.
+  static int32_t st_fixed_point_step_dist(float mm)
+  {
+    float step_dist = prep.step_per_mm*mm*STEP_DIST_SCALAR;
+    int32_t fixed_step_dist = step_dist;
+    if (fixed_step_dist < step_dist) { fixed_step_dist++; }
+    return(fixed_step_dist);
+  }
+
+
+  // Returns the execution time of a fixed-point step distance at the given cycles per step.
+  // NOTE: Only used for partial steps, which are less than a step, or two steps for arc segments.
+  static int32_t st_fixed_point_step_time(uint32_t cycles, int32_t step_dist)
+  {
+    if (cycles < (1UL << (30-STEP_DIST_FRACT_BITS))) {
+      return(((int32_t)cycles*step_dist) >> STEP_DIST_FRACT_BITS);
+    }
+    return((int32_t)(cycles >> STEP_DIST_FRACT_BITS)*step_dist);
+  }
+#endif
+
+
+#ifdef ENABLE_CONTINUOUS_OVERRIDES
+  // Returns the executed override value moved toward the commanded value by at most the slew.
+  static float st_slew_override(float value, uint8_t target, float slew)
+  {
+    if (value < target) {
+      value += slew;
+      if (value > target) { value = target; }
+    } else {
+      value -= slew;
+      if (value < target) { value = target; }
+    }
+    return(value);
+  }
+#endif
+
+
+#ifdef ENABLE_CRUISE_SEGMENT_CACHE
+  // Prepares the next segment with the cached step timing, if it is a full cruise segment. Returns
+  // true, if the segment is complete and added to the segment buffer. Otherwise, the segment is
+  // computed normally.
+  // NOTE: The first full cruise segment still carries the partial step time of the preceding ramp,
+  // so the step timing is cached from the second one.
+  static uint8_t st_prep_cached_cruise_segment(segment_t *prep_segment)
+  {
+    if (prep.cruise_cache < 2) { return(false); }
+    float mm_remaining = pl_profile->millimeters - prep.cruise_mm;
+    if (mm_remaining <= prep.decelerate_after) { return(false); } // End of cruise.
+
+    #ifdef USE_FIXED_POINT_SEGMENT_PREP
+      int32_t step_dist_remaining = st_fixed_point_step_dist(mm_remaining);
+      int32_t n_steps_remaining = (step_dist_remaining+(STEP_DIST_SCALAR-1)) >> STEP_DIST_FRACT_BITS;
+      prep.dt_remainder = st_fixed_point_step_time(prep.cruise_cycles,
+                            (n_steps_remaining << STEP_DIST_FRACT_BITS) - step_dist_remaining);
+    #else
+      float step_dist_remaining = prep.step_per_mm*mm_remaining;
+      float n_steps_remaining = ceil(step_dist_remaining);
+      prep.dt_remainder = (n_steps_remaining - step_dist_remaining)*prep.cruise_inv_rate;
+    #endif
+
+    *prep_segment = prep.cruise_segment;
+    prep_segment->n_step = prep.steps_remaining-n_steps_remaining;
+    #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+      prep_segment->n_step <<= prep_segment->amass_level;
+    #endif
+
+    // Segment complete! Increment segment buffer indices, so stepper ISR can immediately execute it.
+    segment_buffer_head = segment_next_head;
+    if ( ++segment_next_head == SEGMENT_BUFFER_SIZE ) { segment_next_head = 0; }
+
+    pl_profile->millimeters = mm_remaining;
+    prep.steps_remaining = n_steps_remaining;
+    return(true);
+  }
+#endif
+
+
 // Increments the step segment buffer block data ring buffer.
 static uint8_t st_next_block_index(uint8_t block_index)
 {
@@ -579,6 +902,137 @@ static uint8_t st_next_block_index(uint8_t block_index)
 }
 
 
+// Sets the step timing of a segment from the CPU cycles per step event. Applies the AMASS level
+// or timer prescaler and scales the number of step events of the segment accordingly.
+// NOTE: With step bursts, the number of step events is not scaled, as the ISR counts each step event
+// of a burst. A burst cut short by the end of the segment only shortens the pulse train.
+static void st_set_segment_timing(segment_t *segment, uint32_t cycles)
+{
+  #ifdef ENABLE_STEP_BURST
+    // Compute the step events per tick and lengthen the tick to execute them all. The ISR spins through
+    // the pulse train, so limit the burst such that the train takes at most half of the tick. The rest
+    // is left to the ISR itself and the segment preparation of the main program.
+    segment->burst_steps = 0;
+    if (cycles < STEP_BURST_LEVEL1) {
+      if (cycles < STEP_BURST_LEVEL2) { segment->burst_steps = 3; }
+      else { segment->burst_steps = 1; }
+      uint16_t train_cycles = (settings.pulse_microseconds+STEP_BURST_LOW_TIME)*TICKS_PER_MICROSECOND;
+      while (segment->burst_steps) {
+        if ((uint32_t)(2*segment->burst_steps)*train_cycles <= cycles*(segment->burst_steps+1)) { break; }
+        segment->burst_steps >>= 1; // Bursts of 4 down to 2 steps, then none.
+      }
+      cycles *= (segment->burst_steps+1);
+    }
+  #endif
+  #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+    // Compute step timing and multi-axis smoothing level.
+    // NOTE: AMASS overdrives the timer with each level, so only one prescalar is required.
+    if (cycles < AMASS_LEVEL1) { segment->amass_level = 0; }
+    else {
+      if (cycles < AMASS_LEVEL2) { segment->amass_level = 1; }
+      else if (cycles < AMASS_LEVEL3) { segment->amass_level = 2; }
+      else { segment->amass_level = 3; }
+      cycles >>= segment->amass_level;
+      segment->n_step <<= segment->amass_level;
+    }
+    if (cycles < (1UL << 16)) { segment->cycles_per_tick = cycles; } // < 65536 (4.1ms @ 16MHz)
+    else { segment->cycles_per_tick = 0xffff; } // Just set the slowest speed possible.
+  #else
+    // Compute step timing and timer prescalar for normal step generation.
+    if (cycles < (1UL << 16)) { // < 65536  (4.1ms @ 16MHz)
+      segment->prescaler = 1; // prescaler: 0
+      segment->cycles_per_tick = cycles;
+    } else if (cycles < (1UL << 19)) { // < 524288 (32.8ms@16MHz)
+      segment->prescaler = 2; // prescaler: 8
+      segment->cycles_per_tick = cycles >> 3;
+    } else {
+      segment->prescaler = 3; // prescaler: 64
+      if (cycles < (1UL << 22)) { // < 4194304 (262ms@16MHz)
+        segment->cycles_per_tick =  cycles >> 6;
+      } else { // Just set the slowest speed possible. (Around 4 step/sec.)
+        segment->cycles_per_tick = 0xffff;
+      }
+    }
+  #endif
+}
+
+
+#ifdef ENABLE_NATIVE_ARC_BLOCKS
+  // Prepares the Bresenham data of an arc block segment, which steps a short line from the end of the
+  // previous segment to the point on the arc at mm_remaining from the end of the block. Each segment
+  // requires its own stepper block data. Step positions are computed from the start of the arc, so
+  // round-off does not accumulate, and the last segment ends exactly on the planned block steps.
+  // Returns the number of step events of the segment. If zero, no stepper block data is used. Also
+  // returns the exact step distance to the arc point, such that the segment step rate is corrected
+  // for the rounded steps in the same manner as line blocks.
+  static uint32_t st_prep_arc_segment(float mm_remaining, float *step_dist)
+  {
+    uint8_t axis_0 = pl_block->arc_axis_0;
+    uint8_t axis_1 = pl_block->arc_axis_1;
+    float fraction = 1.0 - mm_remaining/prep.arc_millimeters;
+    float theta = fraction*pl_block->arc_angular_travel;
+    float cos_theta = cos(theta);
+    float sin_theta = sin(theta);
+
+    int32_t target_steps[N_AXIS];
+    float target;
+    uint8_t idx;
+    *step_dist = 0.0;
+    for (idx=0; idx<N_AXIS; idx++) {
+      target_steps[idx] = pl_block->steps[idx];
+      if (pl_block->direction_bits & get_direction_pin_mask(idx)) { target_steps[idx] = -target_steps[idx]; }
+      if (mm_remaining > 0.0) {
+        if (idx == axis_0) {
+          target = settings.steps_per_mm[idx]*(pl_block->arc_offset[0]*(1.0-cos_theta) + pl_block->arc_offset[1]*sin_theta);
+        } else if (idx == axis_1) {
+          target = settings.steps_per_mm[idx]*(pl_block->arc_offset[1]*(1.0-cos_theta) - pl_block->arc_offset[0]*sin_theta);
+        } else {
+          target = fraction*target_steps[idx];
+        }
+        target_steps[idx] = lround(target);
+      } else {
+        target = target_steps[idx]; // End of block. Exactly on the block steps.
+      }
+      target_steps[idx] -= prep.arc_steps[idx]; // Segment steps
+      target = fabs(target-prep.arc_steps[idx]);
+      if (target > *step_dist) { *step_dist = target; }
+    }
+
+    uint32_t step_event_count = 0;
+    for (idx=0; idx<N_AXIS; idx++) { step_event_count = max(step_event_count, labs(target_steps[idx])); }
+    if (step_event_count == 0) { return(0); }
+
+    prep.st_block_index = st_next_block_index(prep.st_block_index);
+    st_prep_block = &st_block_buffer[prep.st_block_index];
+    st_prep_block->direction_bits = 0;
+    for (idx=0; idx<N_AXIS; idx++) {
+      prep.arc_steps[idx] += target_steps[idx];
+      if (target_steps[idx] < 0) { st_prep_block->direction_bits |= get_direction_pin_mask(idx); }
+      #ifndef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+        st_prep_block->steps[idx] = labs(target_steps[idx]) << 1;
+      #else
+        st_prep_block->steps[idx] = labs(target_steps[idx]) << MAX_AMASS_LEVEL;
+      #endif
+    }
+    #ifndef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+      st_prep_block->step_event_count = step_event_count << 1;
+    #else
+      st_prep_block->step_event_count = step_event_count << MAX_AMASS_LEVEL;
+    #endif
+    #ifdef ENABLE_DUAL_AXIS
+      #if (DUAL_AXIS_SELECT == X_AXIS)
+        if (st_prep_block->direction_bits & (1<<X_DIRECTION_BIT)) {
+      #elif (DUAL_AXIS_SELECT == Y_AXIS)
+        if (st_prep_block->direction_bits & (1<<Y_DIRECTION_BIT)) {
+      #endif
+        st_prep_block->direction_bits_dual = (1<<DUAL_DIRECTION_BIT);
+      }  else { st_prep_block->direction_bits_dual = 0; }
+    #endif
+    return(step_event_count);
+  }
+#endif
+
+
 /* Prepares step segment buffer. Continuously called from main program.
 
    The segment buffer is an intermediary buffer interface between the execution of steps
@@ -594,6 +1048,23 @@ static uint8_t st_next_block_index(uint8_t block_index)
 */
 void st_prep_buffer()
 {
+  #ifdef ENABLE_MAIN_LOOP_TELEMETRY
+    // Track the longest time between refills in a cycle. The first refill of a cycle only starts timing.
+    static uint32_t prep_time;
+    static uint8_t prep_in_cycle;
+    uint32_t time = system_get_telemetry_time();
+    if (sys.state == STATE_CYCLE) {
+      if (prep_in_cycle) {
+        uint32_t latency = (time-prep_time) & TELEMETRY_TIME_MASK;
+        if (latency > sys_telemetry.max_latency) { sys_telemetry.max_latency = latency; }
+      }
+      prep_in_cycle = true;
+    } else {
+      prep_in_cycle = false;
+    }
+    prep_time = time;
+  #endif
+
   // Block step prep buffer, while in a suspend state and there is no suspend motion to execute.
   if (bit_istrue(sys.step_control,STEP_CONTROL_END_MOTION)) { return; }
 
@@ -604,16 +1075,63 @@ void st_prep_buffer()
 
       // Query planner for a queued block
       if (sys.step_control & STEP_CONTROL_EXECUTE_SYS_MOTION) { pl_block = plan_get_system_motion_block(); }
-      else { pl_block = plan_get_current_block(); }
-      if (pl_block == NULL) { return; } // No planner blocks. Exit.
+      else {
+        #ifdef ENABLE_LAZY_OVERRIDE_REPLAN
+          // Apply a deferred override change before loading a new block from the exit of the last.
+          if (plan_check_override_pending() && !(prep.recalculate_flag & PREP_FLAG_RECALCULATE) &&
+              !(sys.step_control & STEP_CONTROL_EXECUTE_HOLD)) {
+            plan_apply_velocity_profile_update(prep.exit_speed);
+          }
+        #endif
+        pl_block = plan_get_current_block();
+      }
+      if (pl_block == NULL) { // No planner blocks. Exit.
+        #ifdef ENABLE_CONTINUOUS_OVERRIDES
+          // No motion to slew the overrides over. Execute the commanded values.
+          prep.f_override = sys.f_override;
+          prep.r_override = sys.r_override;
+        #endif
+        return;
+      }
+      pl_profile = plan_get_block_profile(pl_block);
+
+      #ifdef ENABLE_CRUISE_SEGMENT_CACHE
+        prep.cruise_cache = 0; // Velocity profile changed. Invalidate cached cruise segment.
+      #endif
 
       // Check if we need to only recompute the velocity profile or load a new block.
+      #ifdef ENABLE_JERK_LIMITED_PROFILES
+        uint8_t ramp_continue = false;
+      #endif
       if (prep.recalculate_flag & PREP_FLAG_RECALCULATE) {
 
+        #ifdef ENABLE_JERK_LIMITED_PROFILES
+          // A re-plan of the executing block may keep its S-curve acceleration ramp. See below.
+          if (prep.ramp_type == RAMP_ACCEL) { ramp_continue = true; }
+        #endif
         prep.recalculate_flag = false;
 
       } else {
 
+        #ifdef ENABLE_SEGMENT_STREAMING
+          prep.stream_block = STREAM_BLOCK_NONE; // Planner blocks take over the stepper block data.
+        #endif
+        #ifdef ENABLE_NATIVE_ARC_BLOCKS
+          if (pl_block->condition & PL_COND_FLAG_ARC_MOTION) {
+            // Arc blocks load the Bresenham data of every segment in st_prep_arc_segment(). Size the
+            // segments to guarantee at least one step, whichever direction the arc is heading.
+            prep.arc_millimeters = pl_profile->millimeters;
+            memset(prep.arc_steps, 0, sizeof(prep.arc_steps));
+            // Each segment is a chord of the arc. Its length is limited to the chord deviating at most
+            // the arc tolerance ($12) from the arc, as for the line segments of mc_arc().
+            float radius = hypot_f(pl_block->arc_offset[0], pl_block->arc_offset[1]);
+            prep.arc_segment_mm = 2.0*sqrt(settings.arc_tolerance*(2.0*radius - settings.arc_tolerance));
+            prep.step_per_mm = settings.steps_per_mm[0];
+            uint8_t idx;
+            for (idx=1; idx<N_AXIS; idx++) { prep.step_per_mm = min(prep.step_per_mm, settings.steps_per_mm[idx]); }
+            prep.req_mm_increment = REQ_MM_INCREMENT_SCALAR*sqrt(N_AXIS)/prep.step_per_mm;
+          } else {
+        #endif
         // Load the Bresenham stepping data for the block.
         prep.st_block_index = st_next_block_index(prep.st_block_index);
 
@@ -633,29 +1151,32 @@ void st_prep_buffer()
         #endif
         uint8_t idx;
         #ifndef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
-          for (idx=0; idx<N_AXIS; idx++) { st_prep_block->steps[idx] = (pl_block->steps[idx] << 1); }
-          st_prep_block->step_event_count = (pl_block->step_event_count << 1);
+          for (idx=0; idx<N_AXIS; idx++) { st_prep_block->steps[idx] = ((uint32_t)pl_block->steps[idx] << 1); }
+          st_prep_block->step_event_count = ((uint32_t)pl_block->step_event_count << 1);
         #else
           // With AMASS enabled, simply bit-shift multiply all Bresenham data by the max AMASS
           // level, such that we never divide beyond the original data anywhere in the algorithm.
           // If the original data is divided, we can lose a step from integer roundoff.
-          for (idx=0; idx<N_AXIS; idx++) { st_prep_block->steps[idx] = pl_block->steps[idx] << MAX_AMASS_LEVEL; }
-          st_prep_block->step_event_count = pl_block->step_event_count << MAX_AMASS_LEVEL;
+          for (idx=0; idx<N_AXIS; idx++) { st_prep_block->steps[idx] = (uint32_t)pl_block->steps[idx] << MAX_AMASS_LEVEL; }
+          st_prep_block->step_event_count = (uint32_t)pl_block->step_event_count << MAX_AMASS_LEVEL;
         #endif
 
         // Initialize segment buffer data for generating the segments.
-        prep.steps_remaining = (float)pl_block->step_event_count;
-        prep.step_per_mm = prep.steps_remaining/pl_block->millimeters;
+        prep.steps_remaining = pl_block->step_event_count;
+        prep.step_per_mm = pl_block->step_event_count/pl_profile->millimeters;
         prep.req_mm_increment = REQ_MM_INCREMENT_SCALAR/prep.step_per_mm;
+        #ifdef ENABLE_NATIVE_ARC_BLOCKS
+          }
+        #endif
         prep.dt_remainder = 0.0; // Reset for new segment block
 
         if ((sys.step_control & STEP_CONTROL_EXECUTE_HOLD) || (prep.recalculate_flag & PREP_FLAG_DECEL_OVERRIDE)) {
           // New block loaded mid-hold. Override planner block entry speed to enforce deceleration.
           prep.current_speed = prep.exit_speed;
-          pl_block->entry_speed_sqr = prep.exit_speed*prep.exit_speed;
+          pl_profile->entry_speed_sqr = prep.exit_speed*prep.exit_speed;
           prep.recalculate_flag &= ~(PREP_FLAG_DECEL_OVERRIDE);
         } else {
-          prep.current_speed = sqrt(pl_block->entry_speed_sqr);
+          prep.current_speed = sqrt(pl_profile->entry_speed_sqr);
         }
       }
 
@@ -666,16 +1187,16 @@ void st_prep_buffer()
 			 hold, override the planner velocities and decelerate to the target exit speed.
 			*/
 			prep.mm_complete = 0.0; // Default velocity profile complete at 0.0mm from end of block.
-			float inv_2_accel = 0.5/pl_block->acceleration;
+			float inv_2_accel = 0.5/pl_profile->acceleration;
 			if (sys.step_control & STEP_CONTROL_EXECUTE_HOLD) { // [Forced Deceleration to Zero Velocity]
 				// Compute velocity profile parameters for a feed hold in-progress. This profile overrides
 				// the planner block profile, enforcing a deceleration to zero speed.
 				prep.ramp_type = RAMP_DECEL;
 				// Compute decelerate distance relative to end of block.
-				float decel_dist = pl_block->millimeters - inv_2_accel*pl_block->entry_speed_sqr;
+				float decel_dist = pl_profile->millimeters - inv_2_accel*pl_profile->entry_speed_sqr;
 				if (decel_dist < 0.0) {
 					// Deceleration through entire planner block. End of feed hold is not in this block.
-					prep.exit_speed = sqrt(pl_block->entry_speed_sqr-2*pl_block->acceleration*pl_block->millimeters);
+					prep.exit_speed = sqrt(pl_profile->entry_speed_sqr-2*pl_profile->acceleration*pl_profile->millimeters);
 				} else {
 					prep.mm_complete = decel_dist; // End of feed hold.
 					prep.exit_speed = 0.0;
@@ -683,7 +1204,7 @@ void st_prep_buffer()
 			} else { // [Normal Operation]
 				// Compute or recompute velocity profile parameters of the prepped planner block.
 				prep.ramp_type = RAMP_ACCEL; // Initialize as acceleration ramp.
-				prep.accelerate_until = pl_block->millimeters;
+				prep.accelerate_until = pl_profile->millimeters;
 
 				float exit_speed_sqr;
 				float nominal_speed;
@@ -694,20 +1215,37 @@ void st_prep_buffer()
           prep.exit_speed = sqrt(exit_speed_sqr);
         }
 
-        nominal_speed = plan_compute_profile_nominal_speed(pl_block);
+        #ifdef ENABLE_CONTINUOUS_OVERRIDES
+          if (settings.override_slew_rate <= 0.0) {
+            prep.f_override = sys.f_override;
+            prep.r_override = sys.r_override;
+          }
+          nominal_speed = plan_compute_profile_override_speed(pl_block, prep.f_override, prep.r_override);
+        #else
+          nominal_speed = plan_compute_profile_nominal_speed(pl_block);
+        #endif
 				float nominal_speed_sqr = nominal_speed*nominal_speed;
+        #if defined(ENABLE_LAZY_OVERRIDE_REPLAN) || defined(ENABLE_CONTINUOUS_OVERRIDES)
+          if (exit_speed_sqr > nominal_speed_sqr) {
+            // The planned exit speed exceeds the executed nominal speed, while an override change is not
+            // yet re-planned or still slewing. Exit at the nominal speed and load the next block from it.
+            exit_speed_sqr = nominal_speed_sqr;
+            prep.exit_speed = nominal_speed;
+            prep.recalculate_flag |= PREP_FLAG_DECEL_OVERRIDE;
+          }
+        #endif
 				float intersect_distance =
-								0.5*(pl_block->millimeters+inv_2_accel*(pl_block->entry_speed_sqr-exit_speed_sqr));
+								0.5*(pl_profile->millimeters+inv_2_accel*(pl_profile->entry_speed_sqr-exit_speed_sqr));
 
-        if (pl_block->entry_speed_sqr > nominal_speed_sqr) { // Only occurs during override reductions.
-          prep.accelerate_until = pl_block->millimeters - inv_2_accel*(pl_block->entry_speed_sqr-nominal_speed_sqr);
+        if (pl_profile->entry_speed_sqr > nominal_speed_sqr) { // Only occurs during override reductions.
+          prep.accelerate_until = pl_profile->millimeters - inv_2_accel*(pl_profile->entry_speed_sqr-nominal_speed_sqr);
           if (prep.accelerate_until <= 0.0) { // Deceleration-only.
             prep.ramp_type = RAMP_DECEL;
-            // prep.decelerate_after = pl_block->millimeters;
+            // prep.decelerate_after = pl_profile->millimeters;
             // prep.maximum_speed = prep.current_speed;
 
             // Compute override block exit speed since it doesn't match the planner exit speed.
-            prep.exit_speed = sqrt(pl_block->entry_speed_sqr - 2*pl_block->acceleration*pl_block->millimeters);
+            prep.exit_speed = sqrt(pl_profile->entry_speed_sqr - 2*pl_profile->acceleration*pl_profile->millimeters);
             prep.recalculate_flag |= PREP_FLAG_DECEL_OVERRIDE; // Flag to load next block as deceleration override.
 
             // TODO: Determine correct handling of parameters in deceleration-only.
@@ -721,34 +1259,64 @@ void st_prep_buffer()
             prep.ramp_type = RAMP_DECEL_OVERRIDE;
           }
 				} else if (intersect_distance > 0.0) {
-					if (intersect_distance < pl_block->millimeters) { // Either trapezoid or triangle types
+					if (intersect_distance < pl_profile->millimeters) { // Either trapezoid or triangle types
 						// NOTE: For acceleration-cruise and cruise-only types, following calculation will be 0.0.
 						prep.decelerate_after = inv_2_accel*(nominal_speed_sqr-exit_speed_sqr);
 						if (prep.decelerate_after < intersect_distance) { // Trapezoid type
 							prep.maximum_speed = nominal_speed;
-							if (pl_block->entry_speed_sqr == nominal_speed_sqr) {
+							if (pl_profile->entry_speed_sqr == nominal_speed_sqr) {
 								// Cruise-deceleration or cruise-only type.
 								prep.ramp_type = RAMP_CRUISE;
 							} else {
 								// Full-trapezoid or acceleration-cruise types
-								prep.accelerate_until -= inv_2_accel*(nominal_speed_sqr-pl_block->entry_speed_sqr);
+								prep.accelerate_until -= inv_2_accel*(nominal_speed_sqr-pl_profile->entry_speed_sqr);
 							}
 						} else { // Triangle type
 							prep.accelerate_until = intersect_distance;
 							prep.decelerate_after = intersect_distance;
-							prep.maximum_speed = sqrt(2.0*pl_block->acceleration*intersect_distance+exit_speed_sqr);
+							prep.maximum_speed = sqrt(2.0*pl_profile->acceleration*intersect_distance+exit_speed_sqr);
 						}
 					} else { // Deceleration-only type
             prep.ramp_type = RAMP_DECEL;
-            // prep.decelerate_after = pl_block->millimeters;
+            // prep.decelerate_after = pl_profile->millimeters;
             // prep.maximum_speed = prep.current_speed;
+
+            #ifdef ENABLE_CONTINUOUS_OVERRIDES
+              // A slewing override reduction may lower the planned exit speed below what this block can
+              // reach. Exit at the reachable speed and load the next block as deceleration override instead.
+              float decel_exit_sqr = pl_profile->entry_speed_sqr - 2*pl_profile->acceleration*pl_profile->millimeters;
+              if (decel_exit_sqr > exit_speed_sqr) {
+                prep.exit_speed = sqrt(decel_exit_sqr);
+                prep.recalculate_flag |= PREP_FLAG_DECEL_OVERRIDE;
+              }
+            #endif
 					}
 				} else { // Acceleration-only type
 					prep.accelerate_until = 0.0;
-					// prep.decelerate_after = 0.0;
+					prep.decelerate_after = 0.0;
 					prep.maximum_speed = prep.exit_speed;
 				}
 			}
+
+      #ifdef ENABLE_JERK_LIMITED_PROFILES
+        // Start the S-curve ramp of the computed profile. When the planner re-plans the executing block
+        // mid-acceleration, which happens every time a streamed block alters the plan, keep the active
+        // ramp if it still accelerates to the same speed and ends before the deceleration. Restarting it
+        // would drop the acceleration to zero every time a new block is streamed.
+        if (prep.ramp_type == RAMP_ACCEL) {
+          float ramp_end = prep.ramp_mm - (prep.ramp_speed+0.5*prep.ramp_delta_speed)*prep.ramp_time;
+          if (ramp_continue && (prep.ramp_speed+prep.ramp_delta_speed == prep.maximum_speed) &&
+              (ramp_end >= prep.decelerate_after)) {
+            prep.accelerate_until = ramp_end;
+          } else {
+            st_ramp_init(pl_profile->millimeters, prep.accelerate_until, prep.maximum_speed);
+          }
+        } else if (prep.ramp_type == RAMP_DECEL) {
+          st_ramp_init(pl_profile->millimeters, prep.mm_complete, prep.exit_speed);
+        } else if (prep.ramp_type == RAMP_DECEL_OVERRIDE) {
+          st_ramp_init(pl_profile->millimeters, prep.accelerate_until, prep.maximum_speed);
+        }
+      #endif
     }
 
     // Initialize new segment
@@ -757,6 +1325,11 @@ void st_prep_buffer()
     // Set new segment to point to the current segment data block.
     prep_segment->st_block_index = prep.st_block_index;
 
+    #ifdef ENABLE_CRUISE_SEGMENT_CACHE
+      if (st_prep_cached_cruise_segment(prep_segment)) { continue; }
+      uint8_t cruise_start = (prep.ramp_type == RAMP_CRUISE);
+    #endif
+
     /*------------------------------------------------------------------------------------
         Compute the average velocity of this new segment by determining the total distance
       traveled over the segment time DT_SEGMENT. The following code first attempts to create
@@ -771,44 +1344,89 @@ void st_prep_buffer()
       the end of planner block (typical) or mid-block at the end of a forced deceleration,
       such as from a feed hold.
     */
-    float dt_max = DT_SEGMENT; // Maximum segment time
+    float dt_segment = DT_SEGMENT; // Segment time and increment of slow segments
+    #ifdef RAMP_SEGMENT_TIME_DIVISOR
+      // Short segments when starting in an acceleration or deceleration ramp.
+      if (prep.ramp_type != RAMP_CRUISE) { dt_segment = DT_SEGMENT_RAMP; }
+    #endif
+    #ifdef ENABLE_NATIVE_ARC_BLOCKS
+      if (pl_block->condition & PL_COND_FLAG_ARC_MOTION) {
+        // Shorten arc segments at high speeds to keep their chords within the arc tolerance. No speed
+        // of the segment exceeds the larger of the current and the maximum speed.
+        float arc_speed = max(prep.current_speed, prep.maximum_speed);
+        if (arc_speed*dt_segment > prep.arc_segment_mm) { dt_segment = prep.arc_segment_mm/arc_speed; }
+      }
+    #endif
+    float dt_max = dt_segment; // Maximum segment time
+    #ifdef CRUISE_SEGMENT_TIME_MULTIPLIER
+      // Long segments when starting in cruise. Shortened back at the start of the deceleration ramp.
+      if (prep.ramp_type == RAMP_CRUISE) {
+        #ifdef ENABLE_NATIVE_ARC_BLOCKS
+          if (!(pl_block->condition & PL_COND_FLAG_ARC_MOTION))
+        #endif
+        { dt_max = DT_SEGMENT_CRUISE; }
+      }
+    #endif
     float dt = 0.0; // Initialize segment time
     float time_var = dt_max; // Time worker variable
     float mm_var; // mm-Distance worker variable
-    float speed_var; // Speed worker variable
-    float mm_remaining = pl_block->millimeters; // New segment distance from end of block.
+    #ifndef ENABLE_JERK_LIMITED_PROFILES
+      float speed_var; // Speed worker variable
+    #endif
+    float mm_remaining = pl_profile->millimeters; // New segment distance from end of block.
     float minimum_mm = mm_remaining-prep.req_mm_increment; // Guarantee at least one step.
     if (minimum_mm < 0.0) { minimum_mm = 0.0; }
 
     do {
       switch (prep.ramp_type) {
         case RAMP_DECEL_OVERRIDE:
-          speed_var = pl_block->acceleration*time_var;
-          if (prep.current_speed-prep.maximum_speed <= speed_var) {
-            // Cruise or cruise-deceleration types only for deceleration override.
-            mm_remaining = prep.accelerate_until;
-            time_var = 2.0*(pl_block->millimeters-mm_remaining)/(prep.current_speed+prep.maximum_speed);
-            prep.ramp_type = RAMP_CRUISE;
-            prep.current_speed = prep.maximum_speed;
-          } else { // Mid-deceleration override ramp.
-            mm_remaining -= time_var*(prep.current_speed - 0.5*speed_var);
-            prep.current_speed -= speed_var;
-          }
+          #ifdef ENABLE_JERK_LIMITED_PROFILES
+            if (st_ramp_advance(&time_var, &mm_remaining, prep.accelerate_until)) {
+              mm_remaining = prep.accelerate_until;
+              prep.ramp_type = RAMP_CRUISE;
+              prep.current_speed = prep.maximum_speed;
+            }
+          #else
+            speed_var = pl_profile->acceleration*time_var;
+            if (prep.current_speed-prep.maximum_speed <= speed_var) {
+              // Cruise or cruise-deceleration types only for deceleration override.
+              mm_remaining = prep.accelerate_until;
+              time_var = 2.0*(pl_profile->millimeters-mm_remaining)/(prep.current_speed+prep.maximum_speed);
+              prep.ramp_type = RAMP_CRUISE;
+              prep.current_speed = prep.maximum_speed;
+            } else { // Mid-deceleration override ramp.
+              mm_remaining -= time_var*(prep.current_speed - 0.5*speed_var);
+              prep.current_speed -= speed_var;
+            }
+          #endif
           break;
         case RAMP_ACCEL:
-          // NOTE: Acceleration ramp only computes during first do-while loop.
-          speed_var = pl_block->acceleration*time_var;
-          mm_remaining -= time_var*(prep.current_speed + 0.5*speed_var);
-          if (mm_remaining < prep.accelerate_until) { // End of acceleration ramp.
-            // Acceleration-cruise, acceleration-deceleration ramp junction, or end of block.
-            mm_remaining = prep.accelerate_until; // NOTE: 0.0 at EOB
-            time_var = 2.0*(pl_block->millimeters-mm_remaining)/(prep.current_speed+prep.maximum_speed);
-            if (mm_remaining == prep.decelerate_after) { prep.ramp_type = RAMP_DECEL; }
-            else { prep.ramp_type = RAMP_CRUISE; }
-            prep.current_speed = prep.maximum_speed;
-          } else { // Acceleration only.
-            prep.current_speed += speed_var;
-          }
+          #ifdef ENABLE_JERK_LIMITED_PROFILES
+            // NOTE: The ramp ends at accelerate_until by time or distance, whichever comes first, such that
+            //   a ramp kept or shortened across a re-plan never runs past the block end.
+            if (st_ramp_advance(&time_var, &mm_remaining, prep.accelerate_until)) { // End of acceleration ramp.
+              mm_remaining = prep.accelerate_until; // NOTE: 0.0 at EOB
+              prep.current_speed = prep.maximum_speed;
+              if (mm_remaining == prep.decelerate_after) {
+                prep.ramp_type = RAMP_DECEL;
+                st_ramp_init(mm_remaining, prep.mm_complete, prep.exit_speed);
+              } else { prep.ramp_type = RAMP_CRUISE; }
+            }
+          #else
+            // NOTE: Acceleration ramp only computes during first do-while loop.
+            speed_var = pl_profile->acceleration*time_var;
+            mm_remaining -= time_var*(prep.current_speed + 0.5*speed_var);
+            if (mm_remaining < prep.accelerate_until) { // End of acceleration ramp.
+              // Acceleration-cruise, acceleration-deceleration ramp junction, or end of block.
+              mm_remaining = prep.accelerate_until; // NOTE: 0.0 at EOB
+              time_var = 2.0*(pl_profile->millimeters-mm_remaining)/(prep.current_speed+prep.maximum_speed);
+              if (mm_remaining == prep.decelerate_after) { prep.ramp_type = RAMP_DECEL; }
+              else { prep.ramp_type = RAMP_CRUISE; }
+              prep.current_speed = prep.maximum_speed;
+            } else { // Acceleration only.
+              prep.current_speed += speed_var;
+            }
+          #endif
           break;
         case RAMP_CRUISE:
           // NOTE: mm_var used to retain the last mm_remaining for incomplete segment time_var calculations.
@@ -820,24 +1438,44 @@ void st_prep_buffer()
             time_var = (mm_remaining - prep.decelerate_after)/prep.maximum_speed;
             mm_remaining = prep.decelerate_after; // NOTE: 0.0 at EOB
             prep.ramp_type = RAMP_DECEL;
+            #ifdef CRUISE_SEGMENT_TIME_MULTIPLIER
+              // End a long cruising segment here, or fill a short one into the ramp as usual.
+              if (dt_max > DT_SEGMENT) {
+                dt_max = dt+time_var;
+                if (dt_max < DT_SEGMENT) { dt_max = DT_SEGMENT; }
+              }
+            #endif
+            #ifdef ENABLE_JERK_LIMITED_PROFILES
+              st_ramp_init(mm_remaining, prep.mm_complete, prep.exit_speed);
+            #endif
           } else { // Cruising only.
             mm_remaining = mm_var;
           }
           break;
         default: // case RAMP_DECEL:
-          // NOTE: mm_var used as a misc worker variable to prevent errors when near zero speed.
-          speed_var = pl_block->acceleration*time_var; // Used as delta speed (mm/min)
-          if (prep.current_speed > speed_var) { // Check if at or below zero speed.
-            // Compute distance from end of segment to end of block.
-            mm_var = mm_remaining - time_var*(prep.current_speed - 0.5*speed_var); // (mm)
-            if (mm_var > prep.mm_complete) { // Typical case. In deceleration ramp.
-              mm_remaining = mm_var;
-              prep.current_speed -= speed_var;
-              break; // Segment complete. Exit switch-case statement. Continue do-while loop.
+          #ifdef ENABLE_JERK_LIMITED_PROFILES
+            if (!st_ramp_advance(&time_var, &mm_var, prep.mm_complete)) {
+              if (mm_var > prep.mm_complete) { // Typical case. In deceleration ramp.
+                mm_remaining = mm_var;
+                break; // Segment complete. Exit switch-case statement. Continue do-while loop.
+              }
             }
-          }
-          // Otherwise, at end of block or end of forced-deceleration.
-          time_var = 2.0*(mm_remaining-prep.mm_complete)/(prep.current_speed+prep.exit_speed);
+            // Otherwise, at end of block or end of forced-deceleration.
+          #else
+            // NOTE: mm_var used as a misc worker variable to prevent errors when near zero speed.
+            speed_var = pl_profile->acceleration*time_var; // Used as delta speed (mm/min)
+            if (prep.current_speed > speed_var) { // Check if at or below zero speed.
+              // Compute distance from end of segment to end of block.
+              mm_var = mm_remaining - time_var*(prep.current_speed - 0.5*speed_var); // (mm)
+              if (mm_var > prep.mm_complete) { // Typical case. In deceleration ramp.
+                mm_remaining = mm_var;
+                prep.current_speed -= speed_var;
+                break; // Segment complete. Exit switch-case statement. Continue do-while loop.
+              }
+            }
+            // Otherwise, at end of block or end of forced-deceleration.
+            time_var = 2.0*(mm_remaining-prep.mm_complete)/(prep.current_speed+prep.exit_speed);
+          #endif
           mm_remaining = prep.mm_complete;
           prep.current_speed = prep.exit_speed;
       }
@@ -847,7 +1485,7 @@ void st_prep_buffer()
         if (mm_remaining > minimum_mm) { // Check for very slow segments with zero steps.
           // Increase segment time to ensure at least one step in segment. Override and loop
           // through distance calculations until minimum_mm or mm_complete.
-          dt_max += DT_SEGMENT;
+          dt_max += dt_segment;
           time_var = dt_max - dt;
         } else {
           break; // **Complete** Exit loop. Segment execution time maxed.
@@ -865,9 +1503,39 @@ void st_prep_buffer()
        Fortunately, this scenario is highly unlikely and unrealistic in CNC machines
        supported by Grbl (i.e. exceeding 10 meters axis travel at 200 step/mm).
     */
-    float step_dist_remaining = prep.step_per_mm*mm_remaining; // Convert mm_remaining to steps
-    float n_steps_remaining = ceil(step_dist_remaining); // Round-up current steps remaining
-    float last_n_steps_remaining = ceil(prep.steps_remaining); // Round-up last steps remaining
+    #ifdef USE_FIXED_POINT_SEGMENT_PREP
+      // Step distances are fixed-point with STEP_DIST_FRACT_BITS fractional bits. Whole step counts
+      // are integers, such that rounding up is a simple add and shift.
+      int32_t step_dist_remaining, n_steps_remaining, last_n_steps_remaining;
+    #else
+      float step_dist_remaining, n_steps_remaining, last_n_steps_remaining;
+    #endif
+    #ifdef ENABLE_NATIVE_ARC_BLOCKS
+      if (pl_block->condition & PL_COND_FLAG_ARC_MOTION) {
+        // Arc segments step to the nearest step of the arc point. The rounded steps take the place
+        // of the partial step of line blocks, which may be either ahead or behind the arc point.
+        float arc_step_dist;
+        last_n_steps_remaining = st_prep_arc_segment(mm_remaining, &arc_step_dist);
+        n_steps_remaining = 0;
+        #ifdef USE_FIXED_POINT_SEGMENT_PREP
+          step_dist_remaining = (last_n_steps_remaining-arc_step_dist)*STEP_DIST_SCALAR;
+        #else
+          step_dist_remaining = last_n_steps_remaining-arc_step_dist;
+        #endif
+        prep_segment->st_block_index = prep.st_block_index;
+      } else
+    #endif
+    {
+      #ifdef USE_FIXED_POINT_SEGMENT_PREP
+        step_dist_remaining = st_fixed_point_step_dist(mm_remaining); // Convert mm_remaining to steps
+        n_steps_remaining = (step_dist_remaining+(STEP_DIST_SCALAR-1)) >> STEP_DIST_FRACT_BITS; // Round-up
+        last_n_steps_remaining = prep.steps_remaining; // Always whole steps
+      #else
+        step_dist_remaining = prep.step_per_mm*mm_remaining; // Convert mm_remaining to steps
+        n_steps_remaining = ceil(step_dist_remaining); // Round-up current steps remaining
+        last_n_steps_remaining = ceil(prep.steps_remaining); // Round-up last steps remaining
+      #endif
+    }
     prep_segment->n_step = last_n_steps_remaining-n_steps_remaining; // Compute number of steps to execute.
 
     // Bail if we are at the end of a feed hold and don't have a step to execute.
@@ -878,6 +1546,23 @@ void st_prep_buffer()
         bit_true(sys.step_control,STEP_CONTROL_END_MOTION);
         return; // Segment not generated, but current step data still retained.
       }
+      #ifdef ENABLE_NATIVE_ARC_BLOCKS
+        if (pl_block->condition & PL_COND_FLAG_ARC_MOTION) {
+          // Arc segment without a step, where the arc path is nearly parallel to an axis and the
+          // other axes move less than a step. Skip it and carry its execution time to the next one.
+          #ifdef USE_FIXED_POINT_SEGMENT_PREP
+            prep.dt_remainder += dt*CYCLES_PER_MINUTE;
+          #else
+            prep.dt_remainder += dt;
+          #endif
+          pl_profile->millimeters = mm_remaining;
+          if (mm_remaining == 0.0) { // End of planner block. All steps already executed.
+            pl_block = NULL;
+            plan_discard_current_block();
+          }
+          continue;
+        }
+      #endif
     }
 
     // Compute segment step rate. Since steps are integers and mm distances traveled are not,
@@ -888,51 +1573,79 @@ void st_prep_buffer()
     // adjusts the whole segment rate to keep step output exact. These rate adjustments are
     // typically very small and do not adversely effect performance, but ensures that Grbl
     // outputs the exact acceleration and velocity profiles as computed by the planner.
-    dt += prep.dt_remainder; // Apply previous segment partial step execute time
-    float inv_rate = dt/(last_n_steps_remaining - step_dist_remaining); // Compute adjusted step rate inverse
-
-    // Compute CPU cycles per step for the prepped segment.
-    uint32_t cycles = ceil( (TICKS_PER_MICROSECOND*1000000*60)*inv_rate ); // (cycles/step)
-
-    #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
-      // Compute step timing and multi-axis smoothing level.
-      // NOTE: AMASS overdrives the timer with each level, so only one prescalar is required.
-      if (cycles < AMASS_LEVEL1) { prep_segment->amass_level = 0; }
-      else {
-        if (cycles < AMASS_LEVEL2) { prep_segment->amass_level = 1; }
-        else if (cycles < AMASS_LEVEL3) { prep_segment->amass_level = 2; }
-        else { prep_segment->amass_level = 3; }
-        cycles >>= prep_segment->amass_level;
-        prep_segment->n_step <<= prep_segment->amass_level;
+    #ifdef USE_FIXED_POINT_SEGMENT_PREP
+      // Segment time and the partial step time are in CPU cycles. The executed step distance is
+      // fixed-point, so the cycles per step are the scaled time divided by it, rounded up. Segments
+      // only last longer than about half a second when very slow, with just a few steps, where the
+      // time is divided in two parts to avoid an overflow.
+      int32_t dt_cycles = (int32_t)(dt*CYCLES_PER_MINUTE) + prep.dt_remainder; // Apply previous partial step time
+      int32_t step_dist = (last_n_steps_remaining << STEP_DIST_FRACT_BITS) - step_dist_remaining;
+      if (step_dist <= 0) {
+        // Segment without a step, which advances less than the 1/256 step resolution. Queue nothing and
+        // carry its execution time to the next segment, as for arc segments without a step.
+        prep.dt_remainder = dt_cycles;
+        pl_profile->millimeters = mm_remaining;
+        if (mm_remaining == prep.mm_complete) { // End of planner block. All steps already executed.
+          if (sys.step_control & STEP_CONTROL_EXECUTE_SYS_MOTION) {
+            bit_true(sys.step_control,STEP_CONTROL_END_MOTION);
+            return;
+          }
+          pl_block = NULL;
+          plan_discard_current_block();
+        }
+        continue;
       }
-      if (cycles < (1UL << 16)) { prep_segment->cycles_per_tick = cycles; } // < 65536 (4.1ms @ 16MHz)
-      else { prep_segment->cycles_per_tick = 0xffff; } // Just set the slowest speed possible.
-    #else
-      // Compute step timing and timer prescalar for normal step generation.
-      if (cycles < (1UL << 16)) { // < 65536  (4.1ms @ 16MHz)
-        prep_segment->prescaler = 1; // prescaler: 0
-        prep_segment->cycles_per_tick = cycles;
-      } else if (cycles < (1UL << 19)) { // < 524288 (32.8ms@16MHz)
-        prep_segment->prescaler = 2; // prescaler: 8
-        prep_segment->cycles_per_tick = cycles >> 3;
+      uint32_t cycles; // (cycles/step)
+      if (dt_cycles < (1L << (31-STEP_DIST_FRACT_BITS))) {
+        cycles = ((dt_cycles << STEP_DIST_FRACT_BITS) + (step_dist-1))/step_dist;
       } else {
-        prep_segment->prescaler = 3; // prescaler: 64
-        if (cycles < (1UL << 22)) { // < 4194304 (262ms@16MHz)
-          prep_segment->cycles_per_tick =  cycles >> 6;
-        } else { // Just set the slowest speed possible. (Around 4 step/sec.)
-          prep_segment->cycles_per_tick = 0xffff;
-        }
+        cycles = (dt_cycles/step_dist) << STEP_DIST_FRACT_BITS;
+        cycles += (((dt_cycles % step_dist) << STEP_DIST_FRACT_BITS) + (step_dist-1))/step_dist;
       }
+
+      // Time of the partial step carried to the next segment. Computed before AMASS scales cycles.
+      prep.dt_remainder = st_fixed_point_step_time(cycles, (n_steps_remaining << STEP_DIST_FRACT_BITS) - step_dist_remaining);
+    #else
+      dt += prep.dt_remainder; // Apply previous segment partial step execute time
+      float inv_rate = dt/(last_n_steps_remaining - step_dist_remaining); // Compute adjusted step rate inverse
+
+      // Compute CPU cycles per step for the prepped segment.
+      uint32_t cycles = ceil( (TICKS_PER_MICROSECOND*1000000*60)*inv_rate ); // (cycles/step)
     #endif
 
+    st_set_segment_timing(prep_segment, cycles);
+
     // Segment complete! Increment segment buffer indices, so stepper ISR can immediately execute it.
     segment_buffer_head = segment_next_head;
     if ( ++segment_next_head == SEGMENT_BUFFER_SIZE ) { segment_next_head = 0; }
 
+    #ifdef ENABLE_CRUISE_SEGMENT_CACHE
+      // Cache the step timing of full cruise segments, which execute entirely at the cruise speed.
+      if (cruise_start && (prep.ramp_type == RAMP_CRUISE)) {
+        #ifdef ENABLE_NATIVE_ARC_BLOCKS
+          if (!(pl_block->condition & PL_COND_FLAG_ARC_MOTION))
+        #endif
+        {
+          if (prep.cruise_cache < 2) { prep.cruise_cache++; }
+          prep.cruise_mm = pl_profile->millimeters - mm_remaining;
+          prep.cruise_segment = *prep_segment;
+          #ifdef USE_FIXED_POINT_SEGMENT_PREP
+            prep.cruise_cycles = cycles;
+          #else
+            prep.cruise_inv_rate = inv_rate;
+          #endif
+        }
+      } else {
+        prep.cruise_cache = 0;
+      }
+    #endif
+
     // Update the appropriate planner and segment data.
-    pl_block->millimeters = mm_remaining;
+    pl_profile->millimeters = mm_remaining;
     prep.steps_remaining = n_steps_remaining;
-    prep.dt_remainder = (n_steps_remaining - step_dist_remaining)*inv_rate;
+    #ifndef USE_FIXED_POINT_SEGMENT_PREP
+      prep.dt_remainder = (n_steps_remaining - step_dist_remaining)*inv_rate;
+    #endif
 
     // Check for exit conditions and flag to load next planner block.
     if (mm_remaining == prep.mm_complete) {
@@ -954,6 +1667,17 @@ void st_prep_buffer()
       }
     }
 
+    #ifdef ENABLE_CONTINUOUS_OVERRIDES
+      // Slew the executed overrides toward the commanded values by the segment time and re-compute the
+      // velocity profile of the executing block with the new nominal speed.
+      if ((prep.f_override != sys.f_override) || (prep.r_override != sys.r_override)) {
+        float slew = settings.override_slew_rate*60.0*dt; // (percent)
+        prep.f_override = st_slew_override(prep.f_override, sys.f_override, slew);
+        prep.r_override = st_slew_override(prep.r_override, sys.r_override, slew);
+        st_update_plan_block_parameters();
+      }
+    #endif
+
   }
 }
 
@@ -969,3 +1693,130 @@ float st_get_realtime_rate()
   }
   return 0.0f;
 }
+
+
+#ifdef ENABLE_SEGMENT_STREAMING
+  // Returns the status of the segment buffer. True, if full.
+  uint8_t st_check_full_segment_buffer()
+  {
+    if (segment_buffer_tail == segment_next_head) { return(true); }
+    return(false);
+  }
+
+
+  // Loads the stepper block data of the streamed segments that follow. The direction mask has a bit
+  // set for each axis moving in the negative direction. Called only when the planner buffer is empty
+  // and the segment buffer is not full, so the next stepper block data is never in use.
+  void st_stream_block(uint32_t *steps, uint8_t direction_mask)
+  {
+    // A block without segments is simply replaced. Otherwise, load the next stepper block data.
+    if (prep.stream_block != STREAM_BLOCK_EMPTY) {
+      prep.st_block_index = st_next_block_index(prep.st_block_index);
+      prep.stream_block = STREAM_BLOCK_EMPTY;
+    }
+    st_prep_block = &st_block_buffer[prep.st_block_index];
+    st_prep_block->direction_bits = 0;
+    st_prep_block->step_event_count = 0;
+    uint8_t idx;
+    for (idx=0; idx<N_AXIS; idx++) {
+      st_prep_block->step_event_count = max(st_prep_block->step_event_count, steps[idx]);
+      if (bit_istrue(direction_mask,bit(idx))) { st_prep_block->direction_bits |= get_direction_pin_mask(idx); }
+      #ifndef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+        st_prep_block->steps[idx] = steps[idx] << 1;
+      #else
+        st_prep_block->steps[idx] = steps[idx] << MAX_AMASS_LEVEL;
+      #endif
+    }
+    #ifndef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+      st_prep_block->step_event_count <<= 1;
+    #else
+      st_prep_block->step_event_count <<= MAX_AMASS_LEVEL;
+    #endif
+    #ifdef ENABLE_DUAL_AXIS
+      #if (DUAL_AXIS_SELECT == X_AXIS)
+        if (st_prep_block->direction_bits & (1<<X_DIRECTION_BIT)) {
+      #elif (DUAL_AXIS_SELECT == Y_AXIS)
+        if (st_prep_block->direction_bits & (1<<Y_DIRECTION_BIT)) {
+      #endif
+        st_prep_block->direction_bits_dual = (1<<DUAL_DIRECTION_BIT);
+      }  else { st_prep_block->direction_bits_dual = 0; }
+    #endif
+  }
+
+
+  // Queues a streamed segment of the last streamed block in the segment buffer. Returns false, if
+  // there is no block to step, the segment has no step events, or more than the segment supports.
+  // Called only when the segment buffer is not full.
+  uint8_t st_stream_segment(uint16_t n_step, uint32_t cycles)
+  {
+    if ((prep.stream_block == STREAM_BLOCK_NONE) || (n_step == 0)) { return(false); }
+    segment_t *segment = &segment_buffer[segment_buffer_head];
+    segment->st_block_index = prep.st_block_index;
+    segment->n_step = n_step;
+    st_set_segment_timing(segment, cycles);
+    #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+      if ((segment->n_step >> segment->amass_level) != n_step) { return(false); } // AMASS overflow
+    #endif
+    prep.stream_block = STREAM_BLOCK_ACTIVE;
+
+    // Segment complete! Increment segment buffer indices, so stepper ISR can immediately execute it.
+    segment_buffer_head = segment_next_head;
+    if ( ++segment_next_head == SEGMENT_BUFFER_SIZE ) { segment_next_head = 0; }
+    return(true);
+  }
+#endif
+
+
+#ifdef ENABLE_CONTINUOUS_OVERRIDES
+  // Called by the planner to plan no slower than the executed overrides, while they slew down.
+  float st_get_executed_feed_override()
+  {
+    return(prep.f_override);
+  }
+
+
+  float st_get_executed_rapid_override()
+  {
+    return(prep.r_override);
+  }
+#endif
+
+
+#ifdef ENABLE_STEPPER_ISR_PROFILE
+  void st_get_isr_profile(st_isr_profile_t *profile)
+  {
+    uint8_t sreg = SREG;
+    cli();
+    memcpy(profile, &isr_profile, sizeof(st_isr_profile_t));
+    SREG = sreg;
+  }
+
+
+  void st_reset_isr_profile()
+  {
+    uint8_t sreg = SREG;
+    cli();
+    memset(&isr_profile, 0, sizeof(st_isr_profile_t));
+    isr_profile.min = 0xff;
+    SREG = sreg;
+  }
+#endif
+
+
+#ifdef USE_SEGMENT_POSITION_COUNTERS
+  // Returns the real-time machine position in steps, including the steps of the executing segment.
+  void st_get_position(int32_t *position)
+  {
+    uint8_t sreg = SREG;
+    cli();
+    memcpy(position, sys_position, sizeof(sys_position));
+    if (st.exec_block != NULL) {
+      uint8_t idx;
+      for (idx=0; idx<N_AXIS; idx++) {
+        if (st.exec_block->direction_bits & get_direction_pin_mask(idx)) { position[idx] -= st.segment_steps[idx]; }
+        else { position[idx] += st.segment_steps[idx]; }
+      }
+    }
+    SREG = sreg;
+  }
+#endif
@@ -50,4 +50,46 @@ void st_update_plan_block_parameters();
 // Called by realtime status reporting if realtime rate reporting is enabled in config.h.
 float st_get_realtime_rate();
 
+#ifdef ENABLE_SEGMENT_STREAMING
+  // Returns the status of the segment buffer. True, if full.
+  uint8_t st_check_full_segment_buffer();
+
+  // Loads the stepper block data of streamed segments. Called by the realtime protocol.
+  void st_stream_block(uint32_t *steps, uint8_t direction_mask);
+
+  // Queues a streamed segment in the segment buffer. Returns false, if the segment is invalid.
+  uint8_t st_stream_segment(uint16_t n_step, uint32_t cycles);
+#endif
+
+#ifdef USE_SEGMENT_POSITION_COUNTERS
+  // Returns the real-time machine position in steps, including the steps of the executing segment.
+  void st_get_position(int32_t *position);
+#endif
+
+#ifdef ENABLE_STEPPER_ISR_PROFILE
+  // Stepper driver interrupt execution times, in Timer2 ticks of 8 CPU cycles. On long runs, the count
+  // and sum stop once the sum is full, so the average holds over the first interrupts. The overrun and
+  // re-entry counts saturate at 65535. The minimum and maximum cover all interrupts.
+  typedef struct {
+    uint32_t count;     // Profiled interrupts in the average
+    uint32_t sum;       // Sum of execution times
+    uint8_t min;
+    uint8_t max;
+    uint16_t overruns;  // Interrupts finished after the next one was due, including re-entries
+    uint16_t reentries; // Interrupts skipped by the busy flag
+  } st_isr_profile_t;
+
+  // Copies the stepper driver interrupt profile.
+  void st_get_isr_profile(st_isr_profile_t *profile);
+
+  // Clears the stepper driver interrupt profile.
+  void st_reset_isr_profile();
+#endif
+
+#ifdef ENABLE_CONTINUOUS_OVERRIDES
+  // Returns the executed feed and rapid override values, while they slew to the commanded values.
+  float st_get_executed_feed_override();
+  float st_get_executed_rapid_override();
+#endif
+
 #endif
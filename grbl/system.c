@@ -93,6 +93,20 @@ uint8_t system_execute_line(char *line)
           break;
       }
       break;
+    #ifdef ENABLE_STEPPER_ISR_PROFILE
+      case 'P' : // Print or clear stepper interrupt profile. Allowed in any state, to profile motions.
+        if ( line[2] == 0 ) { report_isr_profile(); }
+        else if ( (line[2] == 'R') && (line[3] == 0) ) { st_reset_isr_profile(); }
+        else { return(STATUS_INVALID_STATEMENT); }
+        break;
+    #endif
+    #ifdef ENABLE_MAIN_LOOP_TELEMETRY
+      case 'L' : // Print or clear main loop telemetry. Allowed in any state, to record jobs.
+        if ( line[2] == 0 ) { report_telemetry(); }
+        else if ( (line[2] == 'R') && (line[3] == 0) ) { system_reset_telemetry(); }
+        else { return(STATUS_INVALID_STATEMENT); }
+        break;
+    #endif
     default :
       // Block any system command that requires the state as IDLE/ALARM. (i.e. EEPROM)
       if ( !(sys.state == STATE_IDLE || sys.state == STATE_ALARM) ) { return(STATUS_IDLE_ERROR); }
@@ -208,6 +222,68 @@ void system_convert_array_steps_to_mpos(float *position, int32_t *steps)
 }
 
 
+#ifdef ENABLE_FIXED_POINT_COORDINATES
+  // Rational steps per fixed-point unit of each axis, as num/den. Computed from the steps/mm settings
+  // they were last computed for, such that setting changes are picked up upon the next conversion.
+  static float step_ratio_steps_per_mm[N_AXIS];
+  static int32_t step_ratio_num[N_AXIS];
+  static int32_t step_ratio_den[N_AXIS]; // Zero, if the axis has no exact ratio.
+  static int32_t step_ratio_max_fixed[N_AXIS]; // Largest position converted with a single division.
+
+  // Computes the reduced rational steps per fixed-point unit of an axis, if its steps/mm setting has at
+  // most three decimals and the ratio allows exact rounding in 32-bit integer math.
+  static void system_compute_step_ratio(uint8_t idx)
+  {
+    float steps_per_mm = settings.steps_per_mm[idx];
+    step_ratio_steps_per_mm[idx] = steps_per_mm;
+    step_ratio_den[idx] = 0;
+    if (!(steps_per_mm < 1000000.0)) { return; }
+    float num_value = steps_per_mm*1000.0;
+    uint32_t num = lround(num_value);
+    if (fabs(num-num_value) > num*1.0E-7+0.001) { return; } // More than three decimals.
+    uint32_t den = 1000UL*FIXED_POINT_SCALE;
+    uint32_t a = num, b = den;
+    while (b) { uint32_t r = a % b; a = b; b = r; } // Greatest common divisor of num and den.
+    num /= a;
+    den /= a;
+    // The remainder term of the conversion must not overflow. See system_convert_array_fixed_to_steps().
+    if ((num+1) > 0x7FFFFFFFUL/den) { return; }
+    step_ratio_num[idx] = num;
+    step_ratio_den[idx] = den;
+    step_ratio_max_fixed[idx] = (0x7FFFFFFFUL-den/2)/num;
+  }
+
+
+  // Converts fixed-point machine positions to steps, rounding half away from zero like lround(). The
+  // steps are round(position*num/den) in a single division, if the product fits 32-bit math, which
+  // holds for common steps/mm settings within most of the position range. Otherwise, with
+  // position = q*den+r, the steps are q*num + round(r*num/den), which is exact and fits 32-bit math.
+  void system_convert_array_fixed_to_steps(int32_t *steps, int32_t *fixed)
+  {
+    uint8_t idx;
+    for (idx=0; idx<N_AXIS; idx++) {
+      if (settings.steps_per_mm[idx] != step_ratio_steps_per_mm[idx]) { system_compute_step_ratio(idx); }
+      int32_t den = step_ratio_den[idx];
+      if (den) {
+        int32_t remainder;
+        if (labs(fixed[idx]) <= step_ratio_max_fixed[idx]) {
+          remainder = fixed[idx]*step_ratio_num[idx];
+          steps[idx] = 0;
+        } else {
+          remainder = (fixed[idx] % den)*step_ratio_num[idx];
+          steps[idx] = (fixed[idx]/den)*step_ratio_num[idx];
+        }
+        if (remainder < 0) { remainder -= den/2; }
+        else { remainder += den/2; }
+        steps[idx] += remainder/den;
+      } else {
+        steps[idx] = lround(fixed[idx]*(settings.steps_per_mm[idx]/FIXED_POINT_SCALE));
+      }
+    }
+  }
+#endif
+
+
 // Special handlers for setting and clearing Grbl's real-time execution flags.
 void system_set_exec_state_flag(uint8_t mask) {
   uint8_t sreg = SREG;
@@ -250,3 +326,54 @@ void system_clear_exec_motion_overrides() {
   sys_rt_exec_motion_override = 0;
   SREG = sreg;
 }
+
+
+#ifdef ENABLE_MAIN_LOOP_TELEMETRY
+  static volatile uint16_t telemetry_overflows; // Upper 16 bits of the telemetry time
+
+
+  // Telemetry timer overflow interrupt. Extends Timer2 to the 24-bit telemetry time.
+  ISR(TIMER2_OVF_vect) { telemetry_overflows++; }
+
+
+  void system_init_telemetry()
+  {
+    // Configure Timer 2: Free-running telemetry timer. Also read by the stepper interrupt profile.
+    TCCR2A = 0; // Normal operation
+    #if TELEMETRY_PRESCALER == 8
+      TCCR2B = (1<<CS21); // 1/8 prescaler
+    #else
+      TCCR2B = (1<<CS22); // 1/64 prescaler
+    #endif
+    TIMSK2 = (1<<TOIE2); // Enable Timer2 overflow interrupt
+    system_reset_telemetry();
+  }
+
+
+  uint32_t system_get_telemetry_time()
+  {
+    uint8_t sreg = SREG;
+    cli();
+    uint8_t ticks = TCNT2;
+    uint16_t overflows = telemetry_overflows;
+    if ((TIFR2 & (1<<TOV2)) && (ticks < 0x80)) { overflows++; } // Overflow not yet serviced.
+    SREG = sreg;
+    return(((uint32_t)overflows << 8) | ticks);
+  }
+
+
+  uint32_t system_get_telemetry_elapsed(uint32_t start_time)
+  {
+    return((system_get_telemetry_time()-start_time) & TELEMETRY_TIME_MASK);
+  }
+
+
+  void system_reset_telemetry()
+  {
+    uint8_t sreg = SREG;
+    cli();
+    memset(&sys_telemetry, 0, sizeof(sys_telemetry_t));
+    sys_telemetry.planner_low_water = BLOCK_BUFFER_SIZE-1;
+    SREG = sreg;
+  }
+#endif
@@ -95,12 +95,36 @@ extern int32_t sys_position[N_AXIS];      // Real-time machine (aka home) positi
 extern volatile uint8_t sys_rt_exec_state;   // Global realtime executor bitflag variable for state management. See EXEC bitmasks.
 extern volatile uint8_t sys_rt_exec_alarm;   // Global realtime executor bitflag variable for setting various alarms.
 extern volatile uint8_t sys_rt_exec_motion_override; // Global realtime executor bitflag variable for motion-based overrides.
+#ifdef ENABLE_CONTINUOUS_OVERRIDES
+  extern volatile uint8_t sys_rt_f_override_value; // Feed override value of a continuous override command. Zero, if none.
+  extern volatile uint8_t sys_rt_r_override_value; // Rapid override value of a continuous override command. Zero, if none.
+#endif
 
 #ifdef DEBUG
   #define EXEC_DEBUG_REPORT  bit(0)
   extern volatile uint8_t sys_rt_exec_debug;
 #endif
 
+#ifdef ENABLE_MAIN_LOOP_TELEMETRY
+  #ifdef ENABLE_STEPPER_ISR_PROFILE
+    #define TELEMETRY_PRESCALER 8 // Timer2 prescaler, shared with the stepper interrupt profile
+  #else
+    #define TELEMETRY_PRESCALER 64
+  #endif
+  #define TELEMETRY_TIME_MASK 0x00FFFFFF // Telemetry time is 24-bit
+
+  typedef struct {
+    uint32_t max_latency;      // Longest time between step segment buffer refills in a cycle
+    uint32_t max_line_time;    // Longest g-code line execution time
+    uint32_t line_time;        // Sum of g-code line execution times
+    uint32_t line_count;
+    uint32_t realtime_time;    // Running sum of realtime execution time, excluded from the line times
+    uint16_t starvations;      // Step segment buffer ran empty in a cycle with planner blocks left
+    uint8_t planner_low_water; // Fewest blocks in the planner buffer when re-planned in a cycle
+  } sys_telemetry_t;
+  extern sys_telemetry_t sys_telemetry; // Times in Timer2 ticks of TELEMETRY_PRESCALER cycles.
+#endif
+
 // Executes an internal system command, defined as a string starting with a '$'
 uint8_t system_execute_line(char *line);
 
@@ -116,6 +140,11 @@ float system_convert_axis_steps_to_mpos(int32_t *steps, uint8_t idx);
 // Updates a machine 'position' array based on the 'step' array sent.
 void system_convert_array_steps_to_mpos(float *position, int32_t *steps);
 
+#ifdef ENABLE_FIXED_POINT_COORDINATES
+  // Updates a 'step' array based on the fixed-point machine position array sent.
+  void system_convert_array_fixed_to_steps(int32_t *steps, int32_t *fixed);
+#endif
+
 // Special handlers for setting and clearing Grbl's real-time execution flags.
 void system_set_exec_state_flag(uint8_t mask);
 void system_clear_exec_state_flag(uint8_t mask);
@@ -124,4 +153,18 @@ void system_clear_exec_alarm();
 void system_set_exec_motion_override_flag(uint8_t mask);
 void system_clear_exec_motion_overrides();
 
+#ifdef ENABLE_MAIN_LOOP_TELEMETRY
+  // Starts the telemetry timer and clears the telemetry.
+  void system_init_telemetry();
+
+  // Returns the telemetry time in Timer2 ticks.
+  uint32_t system_get_telemetry_time();
+
+  // Returns the Timer2 ticks elapsed since a telemetry time.
+  uint32_t system_get_telemetry_elapsed(uint32_t start_time);
+
+  // Clears the telemetry.
+  void system_reset_telemetry();
+#endif
+
 #endif